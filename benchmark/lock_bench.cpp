@@ -0,0 +1,172 @@
+/*
+ * Lock Benchmark: synchronization/ 락 구현별 경합 처리량 및 공정성 측정
+ *
+ * 측정 항목:
+ *  - 스레드 1, 2, 4, ... max_thread (기본 64) 개가 하나의 락을 두고 경합
+ *  - 각 스레드는 duration 동안 lock → 공유 카운터 증가 + cs_work 만큼 작업 → unlock → out_work 만큼 작업 반복
+ *  - 처리량: 초당 임계 구역 진입 수 (Mops)
+ *  - 공정성: 스레드별 획득 횟수의 min / max 비율 (1.0 = 완전 공정)
+ *  - 모든 스레드는 서로 다른 코어에 고정(pthread_setaffinity_np), 코어 수보다 많으면 순환 배정
+ *
+ * 빌드:
+ *  g++ -std=c++20 -O2 -pthread -I. benchmark/lock_bench.cpp -o lock_bench  (저장소 루트에서)
+ *
+ * 사용:
+ *  ./lock_bench [-t max_thread] [-d duration_ms] [-w cs_work] [-o out_work] [-l lock_name]
+ *  lock_name: spin | mcs | ticket | futex (생략 시 전체)
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "synchronization/spinlock.h"
+#include "synchronization/mcslock.h"
+#include "synchronization/ticketlock.h"
+#include "synchronization/futexmutex.h"
+
+struct LockBenchConfig {
+    size_t max_thread_ = 64;
+    uint64_t duration_ms_ = 200;
+    uint32_t cs_work_ = 16;
+    uint32_t out_work_ = 64;
+    std::string only_;
+};
+
+struct LockBenchResult {
+    double sec_;
+    uint64_t ops_;
+    double fairness_;
+    bool ok_;
+};
+
+struct LockBenchTarget {
+    std::string name_;
+    std::function<LockBenchResult(size_t threads, const LockBenchConfig& cfg)> run_;
+};
+
+static void pin_cpu(size_t idx) {
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpu <= 0) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(idx % static_cast<size_t>(ncpu)), &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        std::cerr << "[WARN] pthread_setaffinity_np cpu(" << idx << ") fail "
+        << "(pin_cpu) " << '\n';
+    }
+}
+
+// 컴파일러가 제거하지 못하는 작업 루프
+static inline void busy_work(uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i) {
+        __asm__ __volatile__("" ::: "memory");
+    }
+}
+
+template <typename Lock>
+static LockBenchResult run_lock(size_t threads, const LockBenchConfig& cfg) {
+    Lock lock;
+    uint64_t shared_cnt = 0; // lock으로 보호되는 공유 카운터
+    std::atomic<bool> go(false);
+    std::atomic<bool> stop(false);
+    std::atomic<size_t> ready(0);
+    std::vector<uint64_t> ops(threads, 0);
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            pin_cpu(t);
+            uint64_t local = 0;
+            ready.fetch_add(1, std::memory_order_relaxed);
+            while (!go.load(std::memory_order_acquire)) {}
+            while (!stop.load(std::memory_order_relaxed)) {
+                lock.lock();
+                ++shared_cnt;
+                busy_work(cfg.cs_work_);
+                lock.unlock();
+                ++local;
+                busy_work(cfg.out_work_);
+            }
+            ops[t] = local;
+        });
+    }
+    while (ready.load(std::memory_order_relaxed) < threads) std::this_thread::yield();
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::milliseconds(cfg.duration_ms_));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& w : workers) w.join();
+    auto end = std::chrono::steady_clock::now();
+
+    LockBenchResult res;
+    res.sec_ = std::chrono::duration<double>(end - start).count();
+    res.ops_ = 0;
+    for (uint64_t v : ops) res.ops_ += v;
+    auto mm = std::minmax_element(ops.begin(), ops.end());
+    res.fairness_ = *mm.second == 0 ? 0.0 : static_cast<double>(*mm.first) / static_cast<double>(*mm.second);
+    res.ok_ = shared_cnt == res.ops_;
+    return res;
+}
+
+static bool parse_args(int argc, char** argv, LockBenchConfig& cfg) {
+    int opt;
+    while ((opt = getopt(argc, argv, "t:d:w:o:l:h")) != -1) {
+        switch (opt) {
+            case 't': cfg.max_thread_ = std::strtoull(optarg, nullptr, 10); break;
+            case 'd': cfg.duration_ms_ = std::strtoull(optarg, nullptr, 10); break;
+            case 'w': cfg.cs_work_ = static_cast<uint32_t>(std::strtoul(optarg, nullptr, 10)); break;
+            case 'o': cfg.out_work_ = static_cast<uint32_t>(std::strtoul(optarg, nullptr, 10)); break;
+            case 'l': cfg.only_ = optarg; break;
+            default:
+                std::cerr << "usage: " << argv[0]
+                << " [-t max_thread] [-d duration_ms] [-w cs_work] [-o out_work] [-l spin|mcs|ticket|futex]\n";
+                return false;
+        }
+    }
+    if (cfg.max_thread_ == 0) cfg.max_thread_ = 1;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    LockBenchConfig cfg;
+    if (!parse_args(argc, argv, cfg)) return 1;
+
+    std::vector<LockBenchTarget> targets = {
+        {"spin", run_lock<SpinLock>},
+        {"mcs", run_lock<MCSLock>},
+        {"ticket", run_lock<TicketLock>},
+        {"futex", run_lock<FutexMutex>},
+    };
+
+    std::cout << std::left
+    << std::setw(8) << "lock" << std::setw(9) << "threads"
+    << std::right
+    << std::setw(10) << "Mops" << std::setw(10) << "fairness" << std::setw(6) << "ok" << '\n';
+
+    for (const LockBenchTarget& target : targets) {
+        if (!cfg.only_.empty() && cfg.only_ != target.name_) continue;
+        for (size_t threads = 1; threads <= cfg.max_thread_; threads <<= 1) {
+            LockBenchResult res = target.run_(threads, cfg);
+            std::cout << std::left
+            << std::setw(8) << target.name_ << std::setw(9) << threads
+            << std::right << std::fixed << std::setprecision(3)
+            << std::setw(10) << static_cast<double>(res.ops_) / res.sec_ / 1e6
+            << std::setw(10) << res.fairness_
+            << std::setw(6) << (res.ok_ ? "yes" : "NO") << '\n';
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,237 @@
+/*
+ * SeqLock Benchmark: 단일 writer / 다중 reader 스냅샷 읽기 처리량 비교 (SeqLock vs RWSpinLock vs DistRWLock)
+ *
+ * 측정 항목:
+ *  - reader 1, 2, 4, ... max_reader (기본 16) 개 + writer 1개가 작은 상태 값(NIC 메타데이터 크기)을 공유
+ *  - reader는 duration 동안 스냅샷 읽기 → 일관성 검사 → read_work 만큼 작업 반복
+ *  - writer는 write_interval_us 마다 값 갱신 (0 이면 쉬지 않고 갱신)
+ *  - 처리량: reader 초당 읽기 수 (Mops), writer 초당 갱신 수 (Kops)
+ *  - torn: 일관성이 깨진 스냅샷 수 (항상 0 이어야 함)
+ *  - 모든 스레드는 서로 다른 코어에 고정(pthread_setaffinity_np), 코어 수보다 많으면 순환 배정
+ *
+ * 빌드:
+ *  g++ -std=c++20 -O2 -pthread -I. benchmark/seqlock_bench.cpp -o seqlock_bench  (저장소 루트에서)
+ *
+ * 사용:
+ *  ./seqlock_bench [-r max_reader] [-d duration_ms] [-i write_interval_us] [-w read_work] [-l lock_name]
+ *  lock_name: seqlock | rwspin | distrw (생략 시 전체)
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "synchronization/seqlock.h"
+#include "synchronization/rwspinlock.h"
+#include "synchronization/distrwlock.h"
+
+// 모든 필드가 gen_에서 파생 → 필드 간 불일치 = torn read
+struct NicSnapshot {
+    uint64_t gen_;
+    uint32_t ip_;
+    uint32_t mtu_;
+    uint8_t mac_[6];
+};
+
+static inline NicSnapshot make_snapshot(uint64_t gen) {
+    NicSnapshot s;
+    s.gen_ = gen;
+    s.ip_ = static_cast<uint32_t>(gen);
+    s.mtu_ = static_cast<uint32_t>(gen * 3);
+    for (int i = 0; i < 6; ++i) s.mac_[i] = static_cast<uint8_t>(gen + i);
+    return s;
+}
+
+static inline bool is_consistent(const NicSnapshot& s) {
+    if (s.ip_ != static_cast<uint32_t>(s.gen_) || s.mtu_ != static_cast<uint32_t>(s.gen_ * 3)) return false;
+    for (int i = 0; i < 6; ++i) {
+        if (s.mac_[i] != static_cast<uint8_t>(s.gen_ + i)) return false;
+    }
+    return true;
+}
+
+struct SeqLockTarget {
+    SeqLock<NicSnapshot> lock_;
+    SeqLockTarget() : lock_(make_snapshot(0)) {}
+    inline void write(const NicSnapshot& v) { lock_.store(v); }
+    inline NicSnapshot read() const { return lock_.load(); }
+};
+
+template <typename RWLock>
+struct RWLockTarget {
+    mutable RWLock lock_;
+    NicSnapshot val_ = make_snapshot(0);
+    inline void write(const NicSnapshot& v) {
+        lock_.lock();
+        val_ = v;
+        lock_.unlock();
+    }
+    inline NicSnapshot read() const {
+        lock_.lock_shared();
+        NicSnapshot v = val_;
+        lock_.unlock_shared();
+        return v;
+    }
+};
+
+struct SeqBenchConfig {
+    size_t max_reader_ = 16;
+    uint64_t duration_ms_ = 200;
+    uint64_t write_interval_us_ = 10;
+    uint32_t read_work_ = 16;
+    std::string only_;
+};
+
+struct SeqBenchResult {
+    double sec_;
+    uint64_t reads_;
+    uint64_t writes_;
+    uint64_t torn_;
+};
+
+struct SeqBenchTarget {
+    std::string name_;
+    std::function<SeqBenchResult(size_t readers, const SeqBenchConfig& cfg)> run_;
+};
+
+static void pin_cpu(size_t idx) {
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpu <= 0) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(idx % static_cast<size_t>(ncpu)), &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        std::cerr << "[WARN] pthread_setaffinity_np cpu(" << idx << ") fail "
+        << "(pin_cpu) " << '\n';
+    }
+}
+
+// 컴파일러가 제거하지 못하는 작업 루프
+static inline void busy_work(uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i) {
+        __asm__ __volatile__("" ::: "memory");
+    }
+}
+
+template <typename Target>
+static SeqBenchResult run_target(size_t readers, const SeqBenchConfig& cfg) {
+    Target target;
+    std::atomic<bool> go(false);
+    std::atomic<bool> stop(false);
+    std::atomic<size_t> ready(0);
+    std::vector<uint64_t> reads(readers, 0);
+    std::vector<uint64_t> torn(readers, 0);
+    uint64_t writes = 0;
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < readers; ++t) {
+        workers.emplace_back([&, t] {
+            pin_cpu(t + 1);
+            uint64_t local = 0;
+            uint64_t bad = 0;
+            ready.fetch_add(1, std::memory_order_relaxed);
+            while (!go.load(std::memory_order_acquire)) {}
+            while (!stop.load(std::memory_order_relaxed)) {
+                NicSnapshot s = target.read();
+                if (!is_consistent(s)) ++bad;
+                ++local;
+                busy_work(cfg.read_work_);
+            }
+            reads[t] = local;
+            torn[t] = bad;
+        });
+    }
+    workers.emplace_back([&] {
+        pin_cpu(0);
+        uint64_t gen = 0;
+        ready.fetch_add(1, std::memory_order_relaxed);
+        while (!go.load(std::memory_order_acquire)) {}
+        auto next = std::chrono::steady_clock::now();
+        while (!stop.load(std::memory_order_relaxed)) {
+            target.write(make_snapshot(++gen));
+            if (cfg.write_interval_us_ == 0) continue;
+            next += std::chrono::microseconds(cfg.write_interval_us_);
+            while (std::chrono::steady_clock::now() < next && !stop.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+            }
+        }
+        writes = gen;
+    });
+    while (ready.load(std::memory_order_relaxed) < readers + 1) std::this_thread::yield();
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::milliseconds(cfg.duration_ms_));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& w : workers) w.join();
+    auto end = std::chrono::steady_clock::now();
+
+    SeqBenchResult res;
+    res.sec_ = std::chrono::duration<double>(end - start).count();
+    res.reads_ = 0;
+    res.torn_ = 0;
+    for (size_t t = 0; t < readers; ++t) {
+        res.reads_ += reads[t];
+        res.torn_ += torn[t];
+    }
+    res.writes_ = writes;
+    return res;
+}
+
+static bool parse_args(int argc, char** argv, SeqBenchConfig& cfg) {
+    int opt;
+    while ((opt = getopt(argc, argv, "r:d:i:w:l:h")) != -1) {
+        switch (opt) {
+            case 'r': cfg.max_reader_ = std::strtoull(optarg, nullptr, 10); break;
+            case 'd': cfg.duration_ms_ = std::strtoull(optarg, nullptr, 10); break;
+            case 'i': cfg.write_interval_us_ = std::strtoull(optarg, nullptr, 10); break;
+            case 'w': cfg.read_work_ = static_cast<uint32_t>(std::strtoul(optarg, nullptr, 10)); break;
+            case 'l': cfg.only_ = optarg; break;
+            default:
+                std::cerr << "usage: " << argv[0]
+                << " [-r max_reader] [-d duration_ms] [-i write_interval_us] [-w read_work] [-l seqlock|rwspin|distrw]\n";
+                return false;
+        }
+    }
+    if (cfg.max_reader_ == 0) cfg.max_reader_ = 1;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    SeqBenchConfig cfg;
+    if (!parse_args(argc, argv, cfg)) return 1;
+
+    std::vector<SeqBenchTarget> targets = {
+        {"seqlock", run_target<SeqLockTarget>},
+        {"rwspin", run_target<RWLockTarget<RWSpinLock>>},
+        {"distrw", run_target<RWLockTarget<DistRWLock>>},
+    };
+
+    std::cout << std::left
+    << std::setw(9) << "lock" << std::setw(9) << "readers"
+    << std::right
+    << std::setw(12) << "read Mops" << std::setw(13) << "write Kops" << std::setw(8) << "torn" << '\n';
+
+    for (const SeqBenchTarget& target : targets) {
+        if (!cfg.only_.empty() && cfg.only_ != target.name_) continue;
+        for (size_t readers = 1; readers <= cfg.max_reader_; readers <<= 1) {
+            SeqBenchResult res = target.run_(readers, cfg);
+            std::cout << std::left
+            << std::setw(9) << target.name_ << std::setw(9) << readers
+            << std::right << std::fixed << std::setprecision(3)
+            << std::setw(12) << static_cast<double>(res.reads_) / res.sec_ / 1e6
+            << std::setw(13) << static_cast<double>(res.writes_) / res.sec_ / 1e3
+            << std::setw(8) << res.torn_ << '\n';
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * SharedBuffer Benchmark: SPSC / MPSC / SPMC / MPMC / SPSC VarLen / MPMC VarLen 처리량 및 지연 측정
+ *
+ * 측정 항목:
+ *  - producer 1..P × consumer 1..C 조합 (버퍼 종류별로 허용되는 조합만 수행)
+ *  - payload 크기(기본 64, 512, 1500, 9000 바이트) × 링 크기(기본 1024, 4096 슬롯)
+ *  - 처리량: Mpps, GB/s
+ *  - handoff 지연: producer가 payload 앞 8바이트에 기록한 timestamp → consumer 수신 시각 차이
+ *    (p50 / p99 / p99.9, 나노초)
+ *  - 모든 스레드는 서로 다른 코어에 고정(pthread_setaffinity_np), 코어 수보다 많으면 순환 배정
+ *
+ * 빌드:
+ *  g++ -std=c++20 -O2 -pthread -I. benchmark/sharedbuffer_bench.cpp -o sharedbuffer_bench  (저장소 루트에서)
+ *
+ * 사용:
+ *  ./sharedbuffer_bench [-p max_producer] [-c max_consumer] [-n items_per_producer]
+ *                       [-s payload,payload,...] [-r ring,ring,...] [-b buffer_name]
+ *  buffer_name: spsc | mpsc | spmc | mpmc | varlen | mpmcvarlen (생략 시 전체)
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sharedbuffer/spsclockfreebuffer.h"
+#include "sharedbuffer/mpsclockfreebuffer.h"
+#include "sharedbuffer/spmclockfreebuffer.h"
+#include "sharedbuffer/mpmclockfreebuffer.h"
+#include "sharedbuffer/spscvarlenbuffer.h"
+#include "sharedbuffer/mpmcvarlenbuffer.h"
+
+#define LATENCY_SAMPLE_SHIFT 4 // 2^4 = 16개당 1개 지연 샘플
+
+struct BenchTarget {
+    std::string name_;
+    bool multi_producer_;
+    bool multi_consumer_;
+    std::function<std::unique_ptr<SharedBuffer>(size_t ring, size_t payload)> make_;
+};
+
+struct BenchConfig {
+    size_t max_producer_ = 4;
+    size_t max_consumer_ = 4;
+    size_t items_ = 200000;
+    std::vector<size_t> payloads_ = {64, 512, 1500, 9000};
+    std::vector<size_t> rings_ = {1024, 4096};
+    std::string only_;
+};
+
+struct BenchResult {
+    double sec_;
+    uint64_t items_;
+    uint64_t bytes_;
+    std::vector<uint64_t> latency_;
+};
+
+static inline uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static inline void cpu_relax(uint32_t& spin, bool oversubscribed) {
+    if (oversubscribed || ++spin >= 1024) {
+        spin = 0;
+        std::this_thread::yield();
+        return;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static void pin_cpu(size_t idx) {
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpu <= 0) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(idx % static_cast<size_t>(ncpu)), &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        std::cerr << "[WARN] pthread_setaffinity_np cpu(" << idx << ") fail "
+        << "(pin_cpu) " << '\n';
+    }
+}
+
+static BenchResult run_once(SharedBuffer& buf, size_t producers, size_t consumers, size_t payload, size_t items) {
+    bool oversubscribed = producers + consumers > static_cast<size_t>(sysconf(_SC_NPROCESSORS_ONLN));
+    std::atomic<bool> go(false);
+    std::atomic<uint64_t> consumed(0);
+    std::atomic<uint64_t> bytes(0);
+    const uint64_t total = static_cast<uint64_t>(items) * producers;
+    std::vector<std::vector<uint64_t>> latency(consumers);
+    std::vector<std::thread> threads;
+
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            pin_cpu(p);
+            std::vector<uint8_t> data(payload, static_cast<uint8_t>(p));
+            uint32_t spin = 0;
+            while (!go.load(std::memory_order_acquire)) {}
+            for (size_t i = 0; i < items;) {
+                uint64_t ts = now_ns();
+                std::memcpy(data.data(), &ts, sizeof(ts));
+                if (buf.enqueue(data.data(), payload) >= 0) {
+                    ++i;
+                    spin = 0;
+                } else {
+                    cpu_relax(spin, oversubscribed);
+                }
+            }
+        });
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            pin_cpu(producers + c);
+            std::vector<uint8_t> out(payload);
+            std::vector<uint64_t>& lat = latency[c];
+            lat.reserve((total >> LATENCY_SAMPLE_SHIFT) / consumers + 16);
+            uint64_t local_bytes = 0;
+            uint64_t cnt = 0;
+            uint32_t spin = 0;
+            while (!go.load(std::memory_order_acquire)) {}
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                int32_t n = buf.dequeue(out.data(), payload);
+                if (n < 0) {
+                    cpu_relax(spin, oversubscribed);
+                    continue;
+                }
+                spin = 0;
+                if ((cnt++ & ((1u << LATENCY_SAMPLE_SHIFT) - 1)) == 0) {
+                    uint64_t ts;
+                    std::memcpy(&ts, out.data(), sizeof(ts));
+                    lat.push_back(now_ns() - ts);
+                }
+                local_bytes += static_cast<uint64_t>(n);
+                consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+            bytes.fetch_add(local_bytes, std::memory_order_relaxed);
+        });
+    }
+
+    uint64_t start = now_ns();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+    uint64_t end = now_ns();
+
+    BenchResult res;
+    res.sec_ = static_cast<double>(end - start) / 1e9;
+    res.items_ = total;
+    res.bytes_ = bytes.load();
+    for (auto& v : latency) res.latency_.insert(res.latency_.end(), v.begin(), v.end());
+    std::sort(res.latency_.begin(), res.latency_.end());
+    return res;
+}
+
+static uint64_t percentile(const std::vector<uint64_t>& sorted, double pct) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(pct / 100.0 * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+
+static std::vector<size_t> parse_list(const char* arg) {
+    std::vector<size_t> out;
+    std::stringstream ss(arg);
+    std::string tok;
+    while (std::getline(ss, tok, ',')) {
+        if (!tok.empty()) out.push_back(static_cast<size_t>(std::strtoull(tok.c_str(), nullptr, 10)));
+    }
+    return out;
+}
+
+static bool parse_args(int argc, char** argv, BenchConfig& cfg) {
+    int opt;
+    while ((opt = getopt(argc, argv, "p:c:n:s:r:b:h")) != -1) {
+        switch (opt) {
+            case 'p': cfg.max_producer_ = std::strtoull(optarg, nullptr, 10); break;
+            case 'c': cfg.max_consumer_ = std::strtoull(optarg, nullptr, 10); break;
+            case 'n': cfg.items_ = std::strtoull(optarg, nullptr, 10); break;
+            case 's': cfg.payloads_ = parse_list(optarg); break;
+            case 'r': cfg.rings_ = parse_list(optarg); break;
+            case 'b': cfg.only_ = optarg; break;
+            default:
+                std::cerr << "usage: " << argv[0]
+                << " [-p max_producer] [-c max_consumer] [-n items_per_producer]"
+                << " [-s payload,...] [-r ring,...] [-b spsc|mpsc|spmc|mpmc|varlen|mpmcvarlen]\n";
+                return false;
+        }
+    }
+    if (cfg.max_producer_ == 0) cfg.max_producer_ = 1;
+    if (cfg.max_consumer_ == 0) cfg.max_consumer_ = 1;
+    for (size_t& s : cfg.payloads_) {
+        if (s < sizeof(uint64_t)) s = sizeof(uint64_t); // timestamp 공간
+        if (s > MAX_NODE_SIZE) s = MAX_NODE_SIZE;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+    if (!parse_args(argc, argv, cfg)) return 1;
+
+    std::vector<BenchTarget> targets = {
+        {"spsc", false, false, [](size_t ring, size_t) { return std::make_unique<SPSCLockFreeBuffer>(ring); }},
+        {"mpsc", true, false, [](size_t ring, size_t) { return std::make_unique<MPSCLockFreeBuffer>(ring); }},
+        {"spmc", false, true, [](size_t ring, size_t) { return std::make_unique<SPMCLockFreeBuffer>(ring); }},
+        {"mpmc", true, true, [](size_t ring, size_t) { return std::make_unique<MPMCLockFreeBuffer>(ring); }},
+        // 동일한 레코드 개수를 담을 수 있는 바이트 용량으로 환산
+        {"varlen", false, false, [](size_t ring, size_t payload) {
+            return std::make_unique<SPSCVarLenBuffer>(ring * (VARLEN_HDR_SIZE + payload + VARLEN_ALIGN)); }},
+        {"mpmcvarlen", true, true, [](size_t ring, size_t payload) {
+            return std::make_unique<MPMCVarLenBuffer>(ring * (VARLEN_HDR_SIZE + payload + VARLEN_ALIGN)); }},
+    };
+
+    std::cout << std::left
+    << std::setw(12) << "buffer" << std::setw(4) << "P" << std::setw(4) << "C"
+    << std::setw(9) << "payload" << std::setw(7) << "ring"
+    << std::right
+    << std::setw(10) << "Mpps" << std::setw(10) << "GB/s"
+    << std::setw(11) << "p50(ns)" << std::setw(11) << "p99(ns)" << std::setw(12) << "p99.9(ns)" << '\n';
+
+    for (const BenchTarget& target : targets) {
+        if (!cfg.only_.empty() && cfg.only_ != target.name_) continue;
+        size_t max_p = target.multi_producer_ ? cfg.max_producer_ : 1;
+        size_t max_c = target.multi_consumer_ ? cfg.max_consumer_ : 1;
+        for (size_t ring : cfg.rings_) {
+            for (size_t payload : cfg.payloads_) {
+                for (size_t p = 1; p <= max_p; ++p) {
+                    for (size_t c = 1; c <= max_c; ++c) {
+                        std::unique_ptr<SharedBuffer> buf = target.make_(ring, payload);
+                        BenchResult res = run_once(*buf, p, c, payload, cfg.items_);
+                        std::cout << std::left
+                        << std::setw(12) << target.name_ << std::setw(4) << p << std::setw(4) << c
+                        << std::setw(9) << payload << std::setw(7) << ring
+                        << std::right << std::fixed << std::setprecision(3)
+                        << std::setw(10) << static_cast<double>(res.items_) / res.sec_ / 1e6
+                        << std::setw(10) << static_cast<double>(res.bytes_) / res.sec_ / 1e9
+                        << std::setw(11) << percentile(res.latency_, 50.0)
+                        << std::setw(11) << percentile(res.latency_, 99.0)
+                        << std::setw(12) << percentile(res.latency_, 99.9) << '\n';
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -12,7 +12,7 @@ struct Mac final {
 
 	// constructor
 	Mac() {}
-	Mac(const Mac& r) { memcpy(this->mac_, r.mac_, SIZE); }
+	Mac(const Mac& r) = default; // trivially copyable (SeqLock<T> 등 memcpy 기반 스냅샷에 사용 가능)
 	Mac(const uint8_t* r) { memcpy(this->mac_, r, SIZE); }
 	Mac(const std::string& r) {
 		std::string s;
@@ -28,7 +28,7 @@ struct Mac final {
 	}
 
 	// assign operator
-	Mac& operator = (const Mac& r) { memcpy(this->mac_, r.mac_, SIZE); return *this; }
+	Mac& operator = (const Mac& r) = default;
 
 	// casting operator
 	explicit operator uint8_t*() const { return const_cast<uint8_t*>(mac_); }
@@ -0,0 +1,148 @@
+/*
+ * Disruptor-Style Bounded Broadcast Ring (Byte Buffer Version)
+ *
+ * 특징:
+ *  - 단일 producer, 복수 consumer 환경에서 모든 consumer가 모든 데이터를 수신 (load balancing 아님)
+ *  - payload는 링에 한 번만 기록되고 모든 consumer가 같은 슬롯을 읽음 → consumer별 큐 복사 제거
+ *  - consumer마다 독립된 sequence cursor(head_)를 64바이트 캐시 라인에 분리 배치
+ *  - producer는 가장 느린 consumer의 cursor를 기준으로 gating
+ *      * gating 값은 producer 로컬에 캐시하고 링이 가득 차 보일 때만 전체 cursor를 다시 스캔
+ *  - consumer는 producer의 tail_ 로컬 사본을 유지하고 비어 보일 때만 다시 읽음
+ *  - CAS 없음, acquire/release 오더링만 사용
+ *  - 2의 제곱 크기 버퍼와 비트 마스크 인덱싱 (mask = size - 1)
+ *  - reserve()/commit(), peek()/release()로 제로카피 경로 제공
+ *
+ * 주의:
+ *  - enqueue()/reserve()는 단일 producer만 호출해야 한다.
+ *  - consumer 번호(0 ~ consumer_cnt-1)마다 단일 스레드만 dequeue()/peek()을 호출해야 한다.
+ *  - 가장 느린 consumer가 따라오지 못하면 링이 가득 차며, enqueue()는 -1을 반환한다.
+ *  - 큐가 파괴될 때는 모든 producer / consumer 스레드가 종료된 상태여야 한다.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "sharedbuffer.h"
+#include "bufferalloc.h"
+
+#define MAX_BROADCAST_SLOT_SIZE 65535
+
+struct alignas(64) BroadcastSlot {
+    uint16_t len_;
+    uint8_t data_[MAX_BROADCAST_SLOT_SIZE];
+};
+
+struct alignas(64) BroadcastCursor {
+    std::atomic<size_t> head_; // 이 consumer가 다음에 읽을 위치
+    size_t tail_cache_;        // 이 consumer가 마지막으로 관찰한 tail_
+};
+
+class BroadcastBuffer {
+private:
+    size_t size_;
+    size_t consumer_cnt_;
+    BufferPtr<BroadcastSlot> buf_;
+    std::unique_ptr<BroadcastCursor[]> cursors_;
+    alignas(64) std::atomic<size_t> tail_; // producer가 다음에 기록할 위치
+    size_t gating_cache_;                  // producer가 마지막으로 계산한 가장 느린 head_
+public:
+    BroadcastBuffer(size_t size, size_t consumer_cnt, const AllocPolicy& policy = AllocPolicy())
+        : consumer_cnt_(consumer_cnt), tail_(0), gating_cache_(0)
+    {
+        if (size < 2) size = 2;
+        // 2의 제곱이 아닐 경우 상위 제곱으로 보정
+        if ((size & (size - 1)) != 0) {
+            size_t cap = 1;
+            while (cap < size)
+                cap <<= 1;
+            size = cap;
+        }
+        if (consumer_cnt_ == 0) consumer_cnt_ = 1;
+        size_ = size;
+        buf_ = make_buffer<BroadcastSlot>(size_, policy);
+        cursors_ = std::make_unique<BroadcastCursor[]>(consumer_cnt_);
+        for (size_t i = 0; i < consumer_cnt_; ++i) {
+            cursors_[i].head_.store(0, std::memory_order_relaxed);
+            cursors_[i].tail_cache_ = 0;
+        }
+    }
+
+    // 단일 producer만 호출해야 함
+    int32_t enqueue(const uint8_t* data, size_t len) {
+        if (len > MAX_BROADCAST_SLOT_SIZE) len = MAX_BROADCAST_SLOT_SIZE;
+        size_t t = tail_.load(std::memory_order_relaxed);
+        if (!has_room(t)) return -1; // full
+        BroadcastSlot& slot = buf_[t & (size_ - 1)];
+        std::memcpy(slot.data_, data, len);
+        slot.len_ = static_cast<uint16_t>(len);
+        tail_.store(t + 1, std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+    // 단일 producer만 호출해야 함
+    int32_t reserve(BufferSpan& span, size_t len) {
+        if (len > MAX_BROADCAST_SLOT_SIZE) len = MAX_BROADCAST_SLOT_SIZE;
+        size_t t = tail_.load(std::memory_order_relaxed);
+        if (!has_room(t)) return -1; // full
+        span.data_ = buf_[t & (size_ - 1)].data_;
+        span.len_ = len;
+        span.idx_ = t;
+        return static_cast<int32_t>(len);
+    }
+    // 단일 producer만 호출해야 함
+    int32_t commit(BufferSpan& span, size_t len) {
+        if (len > span.len_) len = span.len_;
+        buf_[span.idx_ & (size_ - 1)].len_ = static_cast<uint16_t>(len);
+        tail_.store(span.idx_ + 1, std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+
+    // consumer 번호별 단일 스레드만 호출해야 함
+    int32_t dequeue(size_t consumer, uint8_t* out, size_t len) {
+        BroadcastCursor& cur = cursors_[consumer];
+        size_t h = cur.head_.load(std::memory_order_relaxed);
+        if (!has_data(cur, h)) return -1; // empty
+        BroadcastSlot& slot = buf_[h & (size_ - 1)];
+        if (len > slot.len_) len = slot.len_;
+        std::memcpy(out, slot.data_, len);
+        cur.head_.store(h + 1, std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+    // consumer 번호별 단일 스레드만 호출해야 함 (release 전까지 producer는 해당 슬롯을 덮어쓰지 않음)
+    int32_t peek(size_t consumer, BufferSpan& span) {
+        BroadcastCursor& cur = cursors_[consumer];
+        size_t h = cur.head_.load(std::memory_order_relaxed);
+        if (!has_data(cur, h)) return -1; // empty
+        BroadcastSlot& slot = buf_[h & (size_ - 1)];
+        span.data_ = slot.data_;
+        span.len_ = slot.len_;
+        span.idx_ = h;
+        return static_cast<int32_t>(span.len_);
+    }
+    int32_t release(size_t consumer, BufferSpan& span) {
+        cursors_[consumer].head_.store(span.idx_ + 1, std::memory_order_release);
+        return static_cast<int32_t>(span.len_);
+    }
+
+    size_t get_consumer_cnt() const { return consumer_cnt_; }
+
+private:
+    // 가장 느린 consumer 기준으로 빈 슬롯이 있는지 확인
+    inline bool has_room(size_t t) {
+        if (t - gating_cache_ < size_) return true;
+        size_t min_head = t;
+        for (size_t i = 0; i < consumer_cnt_; ++i) {
+            size_t h = cursors_[i].head_.load(std::memory_order_acquire);
+            if (h < min_head) min_head = h;
+        }
+        gating_cache_ = min_head;
+        return t - gating_cache_ < size_;
+    }
+    inline bool has_data(BroadcastCursor& cur, size_t h) {
+        if (h != cur.tail_cache_) return true;
+        cur.tail_cache_ = tail_.load(std::memory_order_acquire);
+        return h != cur.tail_cache_;
+    }
+};
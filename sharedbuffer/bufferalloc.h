@@ -0,0 +1,161 @@
+/*
+ * BufferAlloc: SharedBuffer 링 메모리 할당 정책 (Huge Page / NUMA)
+ *
+ * 특징:
+ *  - AllocPolicy 기본값은 기존과 동일하게 일반 힙(new[])에서 할당
+ *  - huge_page_ 지정 시 mmap 기반 익명 매핑 사용
+ *      * HUGE_PAGE_THP: 2MiB 정렬 매핑 + madvise(MADV_HUGEPAGE) → Transparent Huge Page 유도
+ *      * HUGE_PAGE_2MB / HUGE_PAGE_1GB: mmap(MAP_HUGETLB) → 사전 예약된 hugetlbfs 페이지 사용
+ *        (예약 페이지가 부족하면 [WARN] 출력 후 THP로 대체)
+ *  - numa_node_ >= 0 이면 mbind(MPOL_BIND)로 해당 NUMA 노드에 메모리 고정
+ *  - prefault_ 이면 mbind 이후 모든 페이지를 미리 접근하여 첫 패킷 처리 시 page fault 제거
+ *  - 큰 링의 TLB miss 및 원격 노드 메모리 접근 지연 감소
+ *
+ * 주의:
+ *  - mbind는 libnuma 없이 syscall로 직접 호출 (커널이 NUMA를 지원하지 않으면 [WARN] 후 무시)
+ *  - 할당 실패 시 [ERROR] 출력 후 std::bad_alloc을 던짐 (std::make_unique와 동일)
+ *  - T는 trivially destructible 타입이어야 함 (munmap 시 소멸자 호출 없음)
+ */
+
+#pragma once
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <type_traits>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+
+#define HUGE_PAGE_2MB_SIZE (static_cast<size_t>(1) << 21)
+#define HUGE_PAGE_1GB_SIZE (static_cast<size_t>(1) << 30)
+
+enum HugePage {
+    HUGE_PAGE_NONE = 0,
+    HUGE_PAGE_THP,
+    HUGE_PAGE_2MB,
+    HUGE_PAGE_1GB
+};
+
+struct AllocPolicy {
+    HugePage huge_page_ = HUGE_PAGE_NONE;
+    int numa_node_ = -1;   // -1 이면 NUMA 바인딩 없음
+    bool prefault_ = false;
+};
+
+template <typename T>
+struct BufferDeleter {
+    size_t map_len_; // 0 이면 new[] 할당, 아니면 mmap 길이
+    void operator()(T* p) const {
+        if (p == nullptr) return;
+        if (map_len_ == 0) delete[] p;
+        else munmap(static_cast<void*>(p), map_len_);
+    }
+};
+
+template <typename T>
+using BufferPtr = std::unique_ptr<T[], BufferDeleter<T>>;
+
+namespace BufferAlloc {
+    inline size_t round_up(size_t len, size_t align) {
+        return (len + align - 1) & ~(align - 1);
+    }
+
+    // align 단위로 정렬된 익명 매핑 (앞뒤 여분은 해제)
+    inline void* map_aligned(size_t len, size_t align) {
+        size_t map_len = len + align;
+        void* raw = mmap(nullptr, map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) return nullptr;
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = (start + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+        if (aligned > start) munmap(raw, aligned - start);
+        size_t tail = (start + map_len) - (aligned + len);
+        if (tail > 0) munmap(reinterpret_cast<void*>(aligned + len), tail);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // 정책에 따라 len 바이트 매핑, 실제 매핑 길이를 map_len에 기록
+    inline void* map(size_t len, const AllocPolicy& policy, size_t& map_len) {
+        void* p = nullptr;
+        if (policy.huge_page_ == HUGE_PAGE_2MB || policy.huge_page_ == HUGE_PAGE_1GB) {
+            size_t page = (policy.huge_page_ == HUGE_PAGE_2MB) ? HUGE_PAGE_2MB_SIZE : HUGE_PAGE_1GB_SIZE;
+            int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB
+                        | ((policy.huge_page_ == HUGE_PAGE_2MB) ? MAP_HUGE_2MB : MAP_HUGE_1GB);
+            map_len = round_up(len, page);
+            p = mmap(nullptr, map_len, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (p != MAP_FAILED) return p;
+            std::cerr << "[WARN] mmap MAP_HUGETLB : " << strerror(errno) << " fallback to THP "
+            << "(BufferAlloc::map) " << '\n';
+        }
+        if (policy.huge_page_ != HUGE_PAGE_NONE) {
+            map_len = round_up(len, HUGE_PAGE_2MB_SIZE);
+            p = map_aligned(map_len, HUGE_PAGE_2MB_SIZE);
+            if (p != nullptr && madvise(p, map_len, MADV_HUGEPAGE) != 0) {
+                std::cerr << "[WARN] madvise MADV_HUGEPAGE : " << strerror(errno) << " "
+                << "(BufferAlloc::map) " << '\n';
+            }
+            return p;
+        }
+        map_len = round_up(len, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+        p = mmap(nullptr, map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return (p == MAP_FAILED) ? nullptr : p;
+    }
+
+    // 매핑을 NUMA 노드에 고정
+    inline void bind_node(void* p, size_t len, int node) {
+        const size_t bits = sizeof(unsigned long) * 8;
+        unsigned long mask[16] = {0};
+        if (node < 0 || static_cast<size_t>(node) >= bits * 16) {
+            std::cerr << "[WARN] invalid numa node(" << node << ") "
+            << "(BufferAlloc::bind_node) " << '\n';
+            return;
+        }
+        mask[node / bits] = 1UL << (node % bits);
+        if (syscall(SYS_mbind, p, len, MPOL_BIND, mask, bits * 16, MPOL_MF_MOVE) != 0) {
+            std::cerr << "[WARN] mbind node(" << node << ") : " << strerror(errno) << " "
+            << "(BufferAlloc::bind_node) " << '\n';
+        }
+    }
+}
+
+// 정책에 따라 T[cnt] 할당 (기본 정책은 std::make_unique<T[]>와 동일)
+template <typename T>
+BufferPtr<T> make_buffer(size_t cnt, const AllocPolicy& policy = AllocPolicy()) {
+    static_assert(std::is_trivially_destructible<T>::value, "buffer element must be trivially destructible");
+    if (policy.huge_page_ == HUGE_PAGE_NONE && policy.numa_node_ < 0 && !policy.prefault_)
+        return BufferPtr<T>(new T[cnt](), BufferDeleter<T>{0});
+
+    size_t map_len = 0;
+    void* p = BufferAlloc::map(sizeof(T) * cnt, policy, map_len);
+    if (p == nullptr) {
+        std::cerr << "[ERROR] buffer mmap : " << strerror(errno) << " "
+        << "(make_buffer) " << '\n';
+        throw std::bad_alloc();
+    }
+    if (policy.numa_node_ >= 0)
+        BufferAlloc::bind_node(p, map_len, policy.numa_node_);
+    if (policy.prefault_) {// mbind 이후 접근해야 지정 노드에 페이지가 할당됨
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        volatile uint8_t* bytes = static_cast<volatile uint8_t*>(p);
+        for (size_t off = 0; off < map_len; off += page)
+            bytes[off] = 0;
+    }
+    T* arr = static_cast<T*>(p);
+    for (size_t i = 0; i < cnt; ++i)
+        new (&arr[i]) T; // 익명 매핑은 0으로 초기화되어 있음
+    return BufferPtr<T>(arr, BufferDeleter<T>{map_len});
+}
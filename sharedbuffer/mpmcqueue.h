@@ -0,0 +1,125 @@
+/*
+ * Vyukov Bounded MPMC Lock-Free Queue (Typed / Compile-Time Size Version)
+ *
+ * 특징:
+ *  - 다중 producer, 다중 consumer 환경에서 완전한 lock-free 보장
+ *  - ABA 문제 방지를 위한 per-slot sequence 관리 (MPMCLockFreeBuffer와 동일한 알고리즘)
+ *  - 바이트 직렬화 없이 T를 이동(move)으로 저장 → 포인터, 디스크립터, 작은 구조체 전달에 적합
+ *  - 용량 N은 컴파일 타임 상수(2의 제곱) → 인덱스 mask가 상수로 접힘
+ *  - 가상 함수 없는 final 템플릿 → 호출이 인라인으로 devirtualize 됨
+ *  - head / tail은 false sharing 방지를 위해 64바이트 정렬
+ *
+ * 주의:
+ *  - enqueue()/dequeue()는 busy-spin 기반이며, 가득 참/비어 있음 시 false 반환
+ *  - 큐 파괴 시점에는 모든 producer/consumer 스레드 종료가 보장되어야 함
+ *  - 파괴 시 남아 있는 요소는 소멸자가 호출된다.
+ *
+ * 사용 예시:
+ *  MPMCQueue<Packet*, 1024> q;
+ *  q.enqueue(pkt);
+ *  Packet* out;
+ *  if (q.dequeue(out)) { ... }
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T, size_t N>
+class MPMCQueue final {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MPMCQueue capacity must be a power of two");
+    static_assert(std::is_nothrow_move_constructible<T>::value, "MPMCQueue requires nothrow move");
+    static constexpr size_t MASK = N - 1;
+
+    struct Cell {
+        std::atomic<size_t> seq;
+        alignas(T) unsigned char storage_[sizeof(T)];
+        T* ptr() { return std::launder(reinterpret_cast<T*>(storage_)); }
+    };
+
+private:
+    Cell buf_[N];
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+public:
+    MPMCQueue() : head_(0), tail_(0) {
+        for (size_t i = 0; i < N; ++i)
+            buf_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+    ~MPMCQueue() {
+        size_t h = head_.load(std::memory_order_relaxed);
+        size_t t = tail_.load(std::memory_order_relaxed);
+        for (; h != t; ++h)
+            buf_[h & MASK].ptr()->~T();
+    }
+
+    // 다중 producer 안전
+    template <typename... Args>
+    inline bool emplace(Args&&... args) {
+        size_t t = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = buf_[t & MASK];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(t);
+
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(
+                        t, t + 1,
+                        std::memory_order_relaxed,
+                        std::memory_order_relaxed))
+                {
+                    new (cell.storage_) T(std::forward<Args>(args)...);
+                    cell.seq.store(t + 1, std::memory_order_release);
+                    return true;
+                }
+                // 실패 시 t는 최신 tail_로 갱신됨 → 재시도
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                t = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    inline bool enqueue(T&& item) { return emplace(std::move(item)); }
+    inline bool enqueue(const T& item) { return emplace(item); }
+
+    // 다중 consumer 안전
+    inline bool dequeue(T& out) {
+        size_t h = head_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = buf_[h & MASK];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(h + 1);
+
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(
+                        h, h + 1,
+                        std::memory_order_relaxed,
+                        std::memory_order_relaxed))
+                {
+                    T* item = cell.ptr();
+                    out = std::move(*item);
+                    item->~T();
+                    cell.seq.store(h + N, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // empty
+            } else {
+                h = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 근사치 (동시 접근 중에는 참고용)
+    inline size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    static constexpr size_t capacity() { return N; }
+};
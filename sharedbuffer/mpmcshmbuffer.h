@@ -0,0 +1,362 @@
+/*
+ * Vyukov Bounded MPMC Lock-Free Queue (Shared Memory / Cross-Process Version)
+ *
+ * 특징:
+ *  - MPMCLockFreeBuffer와 동일한 알고리즘을 프로세스 간 공유 메모리(ShmRegion) 위에서 수행
+ *  - head / tail 및 per-slot seq가 모두 매핑 내부에 존재 → 여러 프로세스의 producer/consumer가 직접 경쟁
+ *  - 위치 독립(position-independent) 레이아웃: 매핑 내부에는 포인터 없이 크기/오프셋만 저장
+ *      * [MPMCShmHeader][node 0][node 1]...[node size-1]
+ *      * node = 8바이트 seq + 8바이트 len + payload, node 간격(stride)은 64바이트 단위로 정렬
+ *  - slot_size(노드 payload 최대 길이)를 생성 시 지정 가능 → 공유 메모리 사용량 절감
+ *  - reserve()/commit(), peek()/release(), enqueue_bulk()/dequeue_bulk() 모두 지원
+ *
+ * 사용 방법:
+ *  - 생성 프로세스: create(name, size, slot_size) → 헤더/seq 초기화 후 magic 기록
+ *  - 연결 프로세스: attach(name) 또는 attach_fd(fd) → magic/레이아웃 확인 후 사용
+ *  - name이 nullptr이면 memfd로 생성되며, get_fd()로 얻은 fd를 fork 또는 SCM_RIGHTS로 전달
+ *
+ * 주의:
+ *  - create()/attach() 성공 전에는 enqueue/dequeue를 호출하지 말 것.
+ *  - 슬롯을 점유한 프로세스가 commit/release 전에 죽으면 해당 슬롯은 영구히 점유 상태로 남는다.
+ *  - 생성 프로세스가 파괴되면 이름은 unlink 되지만, 이미 연결된 프로세스의 매핑은 유지된다.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include "sharedbuffer.h"
+#include "shmregion.h"
+
+#define MAX_SHM_NODE_SIZE 65535
+#define MPMC_SHM_MAGIC 0x4d504d4353484d31ULL // "MPMCSHM1"
+
+struct alignas(64) MPMCShmHeader {
+    std::atomic<uint64_t> magic_; // 초기화 완료 표시 (마지막에 release store)
+    uint64_t size_;               // 노드 개수 (2의 제곱)
+    uint64_t slot_size_;          // 노드 payload 최대 길이
+    uint64_t stride_;             // 노드 간 바이트 간격
+    alignas(64) std::atomic<uint64_t> head_;
+    alignas(64) std::atomic<uint64_t> tail_;
+};
+
+struct ShmNode {
+    std::atomic<uint64_t> seq;
+    uint64_t len_;
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory atomics must be address-free");
+
+class MPMCShmBuffer : public SharedBuffer {
+private:
+    ShmRegion region_;
+    MPMCShmHeader* hdr_;
+    uint8_t* nodes_;
+    size_t size_;
+    size_t slot_size_;
+    size_t stride_;
+public:
+    MPMCShmBuffer() : hdr_(nullptr), nodes_(nullptr), size_(0), slot_size_(0), stride_(0) {}
+
+    // 공유 메모리 생성 및 초기화 (name == nullptr 이면 memfd)
+    bool create(const char* name, size_t size, size_t slot_size = MAX_SHM_NODE_SIZE) {
+        if (size < 2) size = 2;
+        // 2의 제곱으로 보정
+        if ((size & (size - 1)) != 0) {
+            size_t cap = 1;
+            while (cap < size) cap <<= 1;
+            size = cap;
+        }
+        if (slot_size > MAX_SHM_NODE_SIZE)
+            slot_size = MAX_SHM_NODE_SIZE;
+        size_t stride = (sizeof(ShmNode) + slot_size + 63) & ~static_cast<size_t>(63);
+        if (!region_.create(name, sizeof(MPMCShmHeader) + size * stride))
+            return false;
+        MPMCShmHeader* hdr = new (region_.get_addr()) MPMCShmHeader();
+        hdr->size_ = size;
+        hdr->slot_size_ = slot_size;
+        hdr->stride_ = stride;
+        hdr->head_.store(0, std::memory_order_relaxed);
+        hdr->tail_.store(0, std::memory_order_relaxed);
+        uint8_t* nodes = reinterpret_cast<uint8_t*>(hdr) + sizeof(MPMCShmHeader);
+        for (size_t i = 0; i < size; ++i) {
+            ShmNode* node = new (nodes + i * stride) ShmNode();
+            node->seq.store(i, std::memory_order_relaxed);
+            node->len_ = 0;
+        }
+        hdr->magic_.store(MPMC_SHM_MAGIC, std::memory_order_release);
+        return bind();
+    }
+    // 다른 프로세스가 생성한 named 영역에 연결
+    bool attach(const char* name) {
+        if (!region_.attach(name))
+            return false;
+        return bind();
+    }
+    // 전달받은 fd에 연결
+    bool attach_fd(int fd) {
+        if (!region_.attach_fd(fd))
+            return false;
+        return bind();
+    }
+    int get_fd() const { return region_.get_fd(); }
+
+public:
+    // 다중 consumer 지원 (SignalBuffer BACKPRESSURE_DROP_OLDEST 사용 가능)
+    bool is_multi_consumer() const override { return true; }
+
+    // 다중 producer 안전
+    int32_t enqueue(const uint8_t* data, size_t len) override {
+        if (len > slot_size_)
+            len = slot_size_;
+
+        while (true) {
+            size_t t = hdr_->tail_.load(std::memory_order_relaxed);
+            ShmNode& slot = node(t);
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(t);
+
+            if (diff == 0) {
+                uint64_t expected = t;
+                if (hdr_->tail_.compare_exchange_weak(
+                        expected, t + 1,
+                        std::memory_order_acq_rel,
+                        std::memory_order_relaxed))
+                {
+                    std::memcpy(node_data(slot), data, len);
+                    slot.len_ = len;
+                    slot.seq.store(t + 1, std::memory_order_release);
+                    return static_cast<int32_t>(len);
+                }
+            } else if (diff < 0) {
+                // 큐가 가득 참
+                return -1;
+            } else {
+                // 다른 producer가 아직 처리 중
+                continue;
+            }
+        }
+    }
+
+    // 다중 consumer 안전
+    int32_t dequeue(uint8_t* out, size_t len) override {
+        while (true) {
+            size_t h = hdr_->head_.load(std::memory_order_relaxed);
+            ShmNode& slot = node(h);
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(h + 1);
+
+            if (diff == 0) {
+                uint64_t expected = h;
+                if (hdr_->head_.compare_exchange_weak(
+                        expected, h + 1,
+                        std::memory_order_acq_rel,
+                        std::memory_order_relaxed))
+                {
+                    if (len > slot.len_)
+                        len = slot.len_;
+                    std::memcpy(out, node_data(slot), len);
+                    slot.seq.store(h + size_, std::memory_order_release);
+                    return static_cast<int32_t>(len);
+                }
+            } else if (diff < 0) {
+                // 큐가 비어 있음
+                return -1;
+            } else {
+                // 다른 consumer가 이미 가져감
+                continue;
+            }
+        }
+    }
+
+    // 다중 producer 안전, 슬롯 점유 후 데이터 위치 반환
+    int32_t reserve(BufferSpan& span, size_t len) override {
+        if (len > slot_size_)
+            len = slot_size_;
+
+        while (true) {
+            size_t t = hdr_->tail_.load(std::memory_order_relaxed);
+            ShmNode& slot = node(t);
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(t);
+
+            if (diff == 0) {
+                uint64_t expected = t;
+                if (hdr_->tail_.compare_exchange_weak(
+                        expected, t + 1,
+                        std::memory_order_acq_rel,
+                        std::memory_order_relaxed))
+                {
+                    span.data_ = node_data(slot);
+                    span.len_ = len;
+                    span.idx_ = t;
+                    return static_cast<int32_t>(len);
+                }
+            } else if (diff < 0) {
+                return -1; // full
+            } else {
+                continue;
+            }
+        }
+    }
+
+    // reserve한 슬롯 유효화
+    int32_t commit(BufferSpan& span, size_t len) override {
+        if (len > span.len_)
+            len = span.len_;
+        ShmNode& slot = node(span.idx_);
+        slot.len_ = len;
+        slot.seq.store(span.idx_ + 1, std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+
+    // 다중 consumer 안전, 슬롯 점유 후 데이터 위치 반환
+    int32_t peek(BufferSpan& span) override {
+        while (true) {
+            size_t h = hdr_->head_.load(std::memory_order_relaxed);
+            ShmNode& slot = node(h);
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(h + 1);
+
+            if (diff == 0) {
+                uint64_t expected = h;
+                if (hdr_->head_.compare_exchange_weak(
+                        expected, h + 1,
+                        std::memory_order_acq_rel,
+                        std::memory_order_relaxed))
+                {
+                    span.data_ = node_data(slot);
+                    span.len_ = slot.len_;
+                    span.idx_ = h;
+                    return static_cast<int32_t>(span.len_);
+                }
+            } else if (diff < 0) {
+                return -1; // empty
+            } else {
+                continue;
+            }
+        }
+    }
+
+    // peek한 슬롯을 producer에게 반환
+    int32_t release(BufferSpan& span) override {
+        ShmNode& slot = node(span.idx_);
+        slot.seq.store(span.idx_ + size_, std::memory_order_release);
+        return static_cast<int32_t>(span.len_);
+    }
+
+    // 다중 producer 안전, 연속된 빈 슬롯을 한 번의 CAS로 일괄 점유
+    int32_t enqueue_bulk(const struct iovec* vec, size_t n) override {
+        if (n > size_)
+            n = size_;
+        if (n == 0)
+            return 0;
+
+        while (true) {
+            size_t t = hdr_->tail_.load(std::memory_order_relaxed);
+            size_t cnt = 0;
+            for (; cnt < n; ++cnt) {
+                if (node(t + cnt).seq.load(std::memory_order_acquire) != t + cnt)
+                    break;
+            }
+            if (cnt == 0) {
+                intptr_t diff = static_cast<intptr_t>(node(t).seq.load(std::memory_order_acquire))
+                                - static_cast<intptr_t>(t);
+                if (diff < 0)
+                    return -1; // full
+                continue;
+            }
+            uint64_t expected = t;
+            if (hdr_->tail_.compare_exchange_weak(
+                    expected, t + cnt,
+                    std::memory_order_acq_rel,
+                    std::memory_order_relaxed))
+            {
+                for (size_t i = 0; i < cnt; ++i) {
+                    ShmNode& slot = node(t + i);
+                    size_t len = vec[i].iov_len;
+                    if (len > slot_size_)
+                        len = slot_size_;
+                    std::memcpy(node_data(slot), vec[i].iov_base, len);
+                    slot.len_ = len;
+                    slot.seq.store(t + i + 1, std::memory_order_release);
+                }
+                return static_cast<int32_t>(cnt);
+            }
+        }
+    }
+
+    // 다중 consumer 안전, 연속된 데이터 슬롯을 한 번의 CAS로 일괄 점유
+    int32_t dequeue_bulk(struct iovec* out_vec, size_t max) override {
+        if (max > size_)
+            max = size_;
+        if (max == 0)
+            return 0;
+
+        while (true) {
+            size_t h = hdr_->head_.load(std::memory_order_relaxed);
+            size_t cnt = 0;
+            for (; cnt < max; ++cnt) {
+                if (node(h + cnt).seq.load(std::memory_order_acquire) != h + cnt + 1)
+                    break;
+            }
+            if (cnt == 0) {
+                intptr_t diff = static_cast<intptr_t>(node(h).seq.load(std::memory_order_acquire))
+                                - static_cast<intptr_t>(h + 1);
+                if (diff < 0)
+                    return -1; // empty
+                continue;
+            }
+            uint64_t expected = h;
+            if (hdr_->head_.compare_exchange_weak(
+                    expected, h + cnt,
+                    std::memory_order_acq_rel,
+                    std::memory_order_relaxed))
+            {
+                for (size_t i = 0; i < cnt; ++i) {
+                    ShmNode& slot = node(h + i);
+                    if (out_vec[i].iov_len > slot.len_)
+                        out_vec[i].iov_len = slot.len_;
+                    std::memcpy(out_vec[i].iov_base, node_data(slot), out_vec[i].iov_len);
+                    slot.seq.store(h + i + size_, std::memory_order_release);
+                }
+                return static_cast<int32_t>(cnt);
+            }
+        }
+    }
+
+private:
+    // 다른 프로세스가 기록한 헤더 검증: 2의 제곱 size, 슬롯 겹침 없음, size * stride가 매핑 안에 들어감 (곱셈 overflow 없이 비교)
+    static bool valid_layout(const MPMCShmHeader* hdr, size_t avail) {
+        if (hdr->size_ < 2 || (hdr->size_ & (hdr->size_ - 1)) != 0) return false;
+        if (hdr->slot_size_ > MAX_SHM_NODE_SIZE) return false;
+        if (hdr->stride_ < sizeof(ShmNode) + hdr->slot_size_ || hdr->stride_ % alignof(ShmNode) != 0) return false;
+        return hdr->size_ <= avail / hdr->stride_;
+    }
+    // 매핑된 영역의 헤더 검증 후 로컬 레이아웃 정보 설정
+    bool bind() {
+        MPMCShmHeader* hdr = static_cast<MPMCShmHeader*>(region_.get_addr());
+        if (region_.get_len() < sizeof(MPMCShmHeader)
+            || hdr->magic_.load(std::memory_order_acquire) != MPMC_SHM_MAGIC
+            || !valid_layout(hdr, region_.get_len() - sizeof(MPMCShmHeader))) {
+            std::cerr << "[ERROR] invalid shared memory layout "
+            << "(MPMCShmBuffer::bind) " << '\n';
+            region_.close_region();
+            return false;
+        }
+        hdr_ = hdr;
+        nodes_ = reinterpret_cast<uint8_t*>(hdr) + sizeof(MPMCShmHeader);
+        size_ = hdr->size_;
+        slot_size_ = hdr->slot_size_;
+        stride_ = hdr->stride_;
+        return true;
+    }
+    inline ShmNode& node(size_t pos) {
+        return *reinterpret_cast<ShmNode*>(nodes_ + (pos & (size_ - 1)) * stride_);
+    }
+    static inline uint8_t* node_data(ShmNode& node) {
+        return reinterpret_cast<uint8_t*>(&node) + sizeof(ShmNode);
+    }
+};
@@ -0,0 +1,319 @@
+/*
+ * Bounded MPMC Variable-Length Record Ring (Byte Buffer Version)
+ *
+ * 특징:
+ *  - 다중 producer, 다중 consumer 환경에서 가변 길이 레코드를 하나의 연속된 바이트 링에 저장
+ *      * 레코드 = 8바이트 헤더(len 4바이트 + 레코드 전체 크기 rec 4바이트) + 8바이트 단위로 패딩된 payload
+ *      * 64바이트 패킷은 72바이트만 차지 → 고정 슬롯(MAX_NODE_SIZE) MPMC 대비 메모리/캐시 사용량이 실제 트래픽에 비례
+ *  - producer / consumer 측 각각 head(예약) + tail(게시) 두 개의 바이트 오프셋 사용
+ *      * producer 예약: prod_head_를 CAS로 레코드 크기만큼 전진 → 예약한 구간에 다른 producer와 겹침 없이 기록
+ *      * consumer 예약: 레코드 길이를 알아야 전진할 수 있으므로 cons_head_에 VARLEN_CLAIM_BIT를 CAS로 세우고
+ *        헤더만 읽은 뒤 전진 (헤더 읽기 구간만 직렬화, payload 복사는 병렬)
+ *      * 게시: 앞선 예약이 모두 게시될 때까지 기다린 뒤 tail을 예약 끝으로 store (예약 순서대로 게시)
+ *      * producer는 consumer tail까지만, consumer는 producer tail까지만 접근 → 읽는 중인 레코드를 덮어쓰지 않음
+ *  - 링 끝에 레코드가 들어가지 않으면 남은 공간을 패딩 레코드(VARLEN_PAD)로 채우고 처음으로 되감음
+ *    (패딩과 레코드를 한 번에 예약하므로 패딩 뒤에는 항상 실제 레코드가 존재)
+ *  - reserve()/commit()은 reserve(len) 크기로 공간을 예약하며, commit()에서 실제 기록 길이만 헤더에 기록
+ *    (예약한 공간은 rec 헤더로 그대로 건너뜀)
+ *  - enqueue_bulk()/dequeue_bulk()는 레코드 N개를 한 번의 CAS로 예약하고 한 번에 게시
+ *  - AllocPolicy로 링 메모리의 huge page(THP/2MiB/1GiB) 및 NUMA 노드 바인딩/prefault 지정 가능
+ *
+ * 메모리 오더링:
+ *  - producer: consumer tail acquire load → 기록 → producer tail release store
+ *  - consumer: producer tail acquire load → 읽기 → consumer tail release store
+ *  - 게시 대기 중 앞선 스레드의 tail을 acquire로 관찰 → 앞선 레코드 기록도 함께 전달됨
+ *  - consumer는 VARLEN_CLAIM_BIT를 세운 동안 [cons_head_, producer tail) 범위의 헤더만 읽음 → producer 기록과 겹치지 않음
+ *
+ * 주의:
+ *  - size는 슬롯 개수가 아닌 바이트 용량이며, 2의 제곱으로 보정된다(최소 VARLEN_MIN_SIZE).
+ *  - 레코드 최대 길이는 min(MAX_VARLEN_SIZE, size/2 - 헤더)이며, 초과분은 잘린다.
+ *  - 링이 가득 차면 enqueue()는 -1을 반환하며, 데이터는 버려진다.
+ *  - 게시는 예약 순서대로 이루어지므로 예약 후 게시 전(reserve~commit, peek~release 포함)에 선점된 스레드가 있으면
+ *    뒤이어 예약한 스레드들은 busy-spin으로 기다린다. consumer 헤더 읽기 중 선점된 경우도 마찬가지
+ *    (완전한 lock-free가 아님, 코어 수 이하의 스레드에서 사용 권장)
+ *  - reserve() 후 commit() 전까지, peek() 후 release() 전까지 해당 구간은 점유 상태로 남으므로
+ *    반드시 짝을 맞춰 호출해야 함
+ *  - 큐 파괴 시점에는 모든 producer/consumer 스레드 종료가 보장되어야 함
+ */
+
+#pragma once
+
+#include <cstring>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#endif
+#include "sharedbuffer.h"
+#include "bufferalloc.h"
+#include "varlen.h"
+
+#define VARLEN_CLAIM_BIT 1 // cons_head_ 예약 중 표시 (레코드 오프셋은 VARLEN_ALIGN 배수이므로 하위 비트는 항상 0)
+
+class MPMCVarLenBuffer : public SharedBuffer {
+private:
+    BufferPtr<uint8_t> buf_;
+    size_t size_;
+    size_t max_len_;
+    alignas(64) std::atomic<size_t> prod_head_; // producer 예약 바이트 오프셋
+    std::atomic<size_t> prod_tail_;             // producer 게시 바이트 오프셋 (consumer는 여기까지 읽음)
+    alignas(64) std::atomic<size_t> cons_head_; // consumer 예약 바이트 오프셋
+    std::atomic<size_t> cons_tail_;             // consumer 반환 바이트 오프셋 (producer는 여기부터 size_ 까지 기록)
+
+public:
+    MPMCVarLenBuffer(size_t size, const AllocPolicy& policy = AllocPolicy()): prod_head_(0),prod_tail_(0),cons_head_(0),cons_tail_(0){
+        if (size < VARLEN_MIN_SIZE) size = VARLEN_MIN_SIZE;
+        if ((size & (size - 1)) != 0) {// 2의 제곱이 아닐 경우 상위 제곱으로 보정
+            size_t cap = 1;
+            while (cap < size)
+                cap <<= 1;
+            size = cap;
+        }
+        size_ = size;
+        max_len_ = size_ / 2 - VARLEN_HDR_SIZE;
+        if (max_len_ > MAX_VARLEN_SIZE) max_len_ = MAX_VARLEN_SIZE;
+        buf_ = make_buffer<uint8_t>(size_, policy);
+    }
+
+    // 다중 consumer 지원 (SignalBuffer BACKPRESSURE_DROP_OLDEST 사용 가능)
+    bool is_multi_consumer() const override { return true; }
+
+    // 다중 producer 안전
+    int32_t enqueue(const uint8_t* data, size_t len) override {
+        if (len > max_len_) len = max_len_;
+        size_t rec = record_size(len);
+        size_t head, need;
+        if (!claim_space(rec, head, need)) return -1; // full
+        size_t pos = place(head, need, rec, static_cast<uint32_t>(len));
+        std::memcpy(&buf_[pos + VARLEN_HDR_SIZE], data, len);
+        publish(prod_tail_, head, head + need);
+        return static_cast<int32_t>(len);
+    }
+    // 다중 consumer 안전
+    int32_t dequeue(uint8_t* out, size_t len) override {
+        size_t head, pos, adv;
+        uint32_t rec_len;
+        if (!claim_record(head, pos, rec_len, adv)) return -1; // empty
+        if (len > rec_len) len = rec_len;
+        std::memcpy(out, &buf_[pos + VARLEN_HDR_SIZE], len);
+        publish(cons_tail_, head, head + adv);
+        return static_cast<int32_t>(len);
+    }
+    int32_t reserve(BufferSpan& span, size_t len) override {
+        if (len > max_len_) len = max_len_;
+        size_t rec = record_size(len);
+        size_t head, need;
+        if (!claim_space(rec, head, need)) return -1; // full
+        size_t pos = place(head, need, rec, 0); // len은 commit()에서 기록
+        span.data_ = &buf_[pos + VARLEN_HDR_SIZE];
+        span.len_ = len;
+        span.idx_ = head;
+        return static_cast<int32_t>(len);
+    }
+    int32_t commit(BufferSpan& span, size_t len) override {
+        if (len > span.len_) len = span.len_;
+        size_t rec = record_size(span.len_);
+        size_t need = wrap_size(span.idx_, rec);
+        size_t pos = (need != rec) ? 0 : (span.idx_ & (size_ - 1));
+        write_hdr(pos, static_cast<uint32_t>(len));
+        publish(prod_tail_, span.idx_, span.idx_ + need);
+        return static_cast<int32_t>(len);
+    }
+    int32_t peek(BufferSpan& span) override {
+        size_t head, pos, adv;
+        uint32_t rec_len;
+        if (!claim_record(head, pos, rec_len, adv)) return -1; // empty
+        span.data_ = &buf_[pos + VARLEN_HDR_SIZE];
+        span.len_ = rec_len;
+        span.idx_ = head;
+        return static_cast<int32_t>(rec_len);
+    }
+    int32_t release(BufferSpan& span) override {
+        size_t pos, adv;
+        uint32_t rec_len;
+        read_record(span.idx_, pos, rec_len, adv);
+        publish(cons_tail_, span.idx_, span.idx_ + adv);
+        return static_cast<int32_t>(span.len_);
+    }
+    // 들어가는 만큼의 레코드를 한 번의 CAS로 예약, 성공 시 삽입된 개수 반환
+    int32_t enqueue_bulk(const struct iovec* vec, size_t n) override {
+        if (n == 0)
+            return 0;
+
+        size_t head = prod_head_.load(std::memory_order_relaxed);
+        size_t cnt, need;
+        while (true) {
+            size_t free = size_ - (head - cons_tail_.load(std::memory_order_acquire));
+            cnt = 0;
+            need = 0;
+            for (; cnt < n; ++cnt) {
+                size_t step = wrap_size(head + need, record_size(clamp_len(vec[cnt].iov_len)));
+                if (need + step > free)
+                    break;
+                need += step;
+            }
+            if (cnt == 0) {
+                size_t cur = prod_head_.load(std::memory_order_relaxed);
+                if (cur == head)
+                    return -1; // full
+                head = cur;
+                continue;
+            }
+            if (prod_head_.compare_exchange_weak(head, head + need, std::memory_order_relaxed, std::memory_order_relaxed))
+                break;
+        }
+        size_t off = head;
+        for (size_t i = 0; i < cnt; ++i) {
+            size_t len = clamp_len(vec[i].iov_len);
+            size_t rec = record_size(len);
+            size_t step = wrap_size(off, rec);
+            size_t pos = place(off, step, rec, static_cast<uint32_t>(len));
+            std::memcpy(&buf_[pos + VARLEN_HDR_SIZE], vec[i].iov_base, len);
+            off += step;
+        }
+        publish(prod_tail_, head, head + need);
+        return static_cast<int32_t>(cnt);
+    }
+    // 게시된 레코드를 최대 max개 한 번에 예약
+    int32_t dequeue_bulk(struct iovec* out_vec, size_t max) override {
+        if (max == 0)
+            return 0;
+
+        size_t head, tail;
+        if (!lock_head(head, tail))
+            return -1; // empty
+        size_t cnt = 0;
+        size_t adv = 0;
+        for (; cnt < max && head + adv != tail; ++cnt) {
+            size_t pos, step;
+            uint32_t rec_len;
+            read_record(head + adv, pos, rec_len, step);
+            adv += step;
+        }
+        cons_head_.store(head + adv, std::memory_order_release);
+        size_t off = head;
+        for (size_t i = 0; i < cnt; ++i) {
+            size_t pos, step;
+            uint32_t rec_len;
+            read_record(off, pos, rec_len, step);
+            if (out_vec[i].iov_len > rec_len)
+                out_vec[i].iov_len = rec_len;
+            std::memcpy(out_vec[i].iov_base, &buf_[pos + VARLEN_HDR_SIZE], out_vec[i].iov_len);
+            off += step;
+        }
+        publish(cons_tail_, head, head + adv);
+        return static_cast<int32_t>(cnt);
+    }
+
+private:
+    // rec 바이트 레코드를 기록할 공간 예약, need: 링 끝 패딩을 포함한 예약 크기
+    bool claim_space(size_t rec, size_t& head, size_t& need) {
+        head = prod_head_.load(std::memory_order_relaxed);
+        while (true) {
+            need = wrap_size(head, rec);
+            if (need > size_ - (head - cons_tail_.load(std::memory_order_acquire))) {
+                size_t cur = prod_head_.load(std::memory_order_relaxed);
+                if (cur == head)
+                    return false; // full
+                head = cur;
+                continue;
+            }
+            if (prod_head_.compare_exchange_weak(head, head + need, std::memory_order_relaxed, std::memory_order_relaxed))
+                return true;
+        }
+    }
+    // 게시된 레코드 하나 예약, adv: 패딩을 포함한 예약 크기
+    bool claim_record(size_t& head, size_t& pos, uint32_t& rec_len, size_t& adv) {
+        size_t tail;
+        if (!lock_head(head, tail))
+            return false; // empty
+        read_record(head, pos, rec_len, adv);
+        cons_head_.store(head + adv, std::memory_order_release);
+        return true;
+    }
+    // cons_head_에 VARLEN_CLAIM_BIT를 세워 헤더를 읽는 동안 다른 consumer의 예약을 막음, 비어 있으면 false
+    // (헤더를 읽은 뒤 cons_head_ store로 해제, 레코드 복사는 해제 후 수행)
+    bool lock_head(size_t& head, size_t& tail) {
+        head = cons_head_.load(std::memory_order_relaxed);
+        while (true) {
+            if (head & VARLEN_CLAIM_BIT) {
+                pause();
+                head = cons_head_.load(std::memory_order_relaxed);
+                continue;
+            }
+            tail = prod_tail_.load(std::memory_order_acquire);
+            if (head == tail)
+                return false; // empty
+            if (cons_head_.compare_exchange_weak(head, head | VARLEN_CLAIM_BIT, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+    }
+    // 앞선 예약이 모두 게시될 때까지 기다린 뒤 from → to 게시
+    static inline void publish(std::atomic<size_t>& tail, size_t from, size_t to) {
+        while (tail.load(std::memory_order_acquire) != from)
+            pause();
+        tail.store(to, std::memory_order_release);
+    }
+    // 예약 구간(need)에 패딩 / 헤더 기록 후 레코드 위치 반환
+    inline size_t place(size_t head, size_t need, size_t rec, uint32_t len) {
+        size_t pos = head & (size_ - 1);
+        if (need != rec) {// 링 끝 공간을 패딩으로 소진하고 처음부터 기록
+            write_hdr(pos, VARLEN_PAD);
+            pos = 0;
+        }
+        write_hdr(pos, len);
+        write_rec(pos, static_cast<uint32_t>(rec));
+        return pos;
+    }
+    // 게시된(또는 점유 중인) head 위치 레코드 해석, 패딩이면 처음으로 되감음
+    inline void read_record(size_t head, size_t& pos, uint32_t& rec_len, size_t& adv) const {
+        pos = head & (size_ - 1);
+        adv = 0;
+        rec_len = read_hdr(pos);
+        if (rec_len == VARLEN_PAD) {
+            adv = size_ - pos;
+            pos = 0;
+            rec_len = read_hdr(pos);
+        }
+        adv += read_rec(pos);
+    }
+    // head 위치에 rec 바이트 레코드를 둘 때 필요한 크기 (끝에 들어가지 않으면 잔여 공간 포함)
+    inline size_t wrap_size(size_t head, size_t rec) const {
+        size_t contig = size_ - (head & (size_ - 1));
+        return (rec > contig) ? contig + rec : rec;
+    }
+    inline size_t clamp_len(size_t len) const {
+        return len > max_len_ ? max_len_ : len;
+    }
+    static inline size_t record_size(size_t len) {
+        return VARLEN_HDR_SIZE + ((len + VARLEN_ALIGN - 1) & ~static_cast<size_t>(VARLEN_ALIGN - 1));
+    }
+    inline void write_hdr(size_t pos, uint32_t len) {
+        std::memcpy(&buf_[pos], &len, sizeof(len));
+    }
+    inline void write_rec(size_t pos, uint32_t rec) {
+        std::memcpy(&buf_[pos + sizeof(uint32_t)], &rec, sizeof(rec));
+    }
+    inline uint32_t read_hdr(size_t pos) const {
+        uint32_t len;
+        std::memcpy(&len, &buf_[pos], sizeof(len));
+        return len;
+    }
+    inline uint32_t read_rec(size_t pos) const {
+        uint32_t rec;
+        std::memcpy(&rec, &buf_[pos + sizeof(uint32_t)], sizeof(rec));
+        return rec;
+    }
+    static inline void pause() {
+    #if defined(_MSC_VER)
+        _mm_pause();
+    #elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+    #elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+    #elif defined(__riscv)
+        __asm__ __volatile__("pause");
+    #endif
+    }
+};
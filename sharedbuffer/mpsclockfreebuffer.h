@@ -9,12 +9,16 @@
  *  - 2의 제곱 크기 버퍼 및 비트 마스크 인덱싱으로 모듈로(mod) 연산 제거
  *  - false sharing 방지를 위한 64바이트 정렬 적용
  *  - & mask 연산 사용 mask = size - 1 
+ *  - reserve()/commit(), peek()/release()로 슬롯 메모리에 직접 쓰고 읽는 제로카피 경로 제공
+ *  - enqueue_bulk()는 연속 슬롯 N개를 한 번의 CAS로, dequeue_bulk()는 한 번의 head store로 처리
+ *  - AllocPolicy로 링 메모리의 huge page(THP/2MiB/1GiB) 및 NUMA 노드 바인딩/prefault 지정 가능
  *
  * 주의:
  *  - enqueue()는 다중 producer 동시 접근에 안전하나, dequeue()는 단일 consumer 전용이다.
  *  - 경쟁 상황에서 busy-spin(continue 루프)이 발생할 수 있으며,
  *    필요 시 _mm_pause() 또는 std::this_thread::yield() 삽입 권장.
  *  - 큐가 파괴될 때는 모든 producer / consumer 스레드가 종료된 상태여야 한다.
+ *  - reserve()는 commit()과, peek()은 release()와 반드시 짝을 맞춰 호출해야 한다.
  *
  */
 
@@ -26,23 +30,17 @@
 #include <memory>
 #include <cassert>
 #include "sharedbuffer.h"
-
-#define MAX_NODE_SIZE 65535
-
-struct alignas(64) Node {
-    std::atomic<size_t> seq;
-    uint16_t len_;
-    uint8_t data_[MAX_NODE_SIZE];
-};
+#include "bufferalloc.h"
+#include "node.h"
 
 class MPSCLockFreeBuffer : public SharedBuffer{
 private:
     size_t size_;
-    std::unique_ptr<Node[]> buf_;
+    BufferPtr<Node> buf_;
     alignas(64) std::atomic<size_t> head_; // single consumer
     alignas(64) std::atomic<size_t> tail_; // multi producer
 public:
-    MPSCLockFreeBuffer(size_t size) : head_(0), tail_(0)
+    MPSCLockFreeBuffer(size_t size, const AllocPolicy& policy = AllocPolicy()) : head_(0), tail_(0)
     {
         if (size < 2) size = 2;
         // 2의 제곱으로 보정
@@ -52,7 +50,7 @@ public:
             size = cap;
         }
         size_ = size;
-        buf_ = std::make_unique<Node[]>(size_);
+        buf_ = make_buffer<Node>(size_, policy);
         for (size_t i = 0; i < size_; ++i)
             buf_[i].seq.store(i, std::memory_order_relaxed);
     }
@@ -113,4 +111,131 @@ public:
         head_.store(h + 1, std::memory_order_release);
         return static_cast<int32_t>(len);
     }
-};
\ No newline at end of file
+
+    // 다중 producer 안전, 슬롯 점유 후 데이터 위치 반환
+    int32_t reserve(BufferSpan& span, size_t len) override {
+        if (len > MAX_NODE_SIZE)
+            len = MAX_NODE_SIZE;
+
+        while (true) {
+            size_t t = tail_.load(std::memory_order_relaxed);
+            Node& slot = buf_[t & (size_ - 1)];
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(t);
+
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(
+                        t, t + 1,
+                        std::memory_order_acq_rel,
+                        std::memory_order_relaxed))
+                {
+                    span.data_ = slot.data_;
+                    span.len_ = len;
+                    span.idx_ = t;
+                    return static_cast<int32_t>(len);
+                }
+            } else if (diff < 0) {
+                return -1; // full
+            } else {
+                continue;
+            }
+        }
+    }
+
+    // reserve한 슬롯 유효화
+    int32_t commit(BufferSpan& span, size_t len) override {
+        if (len > span.len_)
+            len = span.len_;
+        Node& slot = buf_[span.idx_ & (size_ - 1)];
+        slot.len_ = static_cast<uint16_t>(len);
+        slot.seq.store(span.idx_ + 1, std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+
+    // 단일 consumer 전용
+    int32_t peek(BufferSpan& span) override {
+        size_t h = head_.load(std::memory_order_relaxed);
+        Node& slot = buf_[h & (size_ - 1)];
+        size_t seq = slot.seq.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(h + 1);
+
+        if (diff < 0)
+            return -1; // empty
+
+        span.data_ = slot.data_;
+        span.len_ = slot.len_;
+        span.idx_ = h;
+        return static_cast<int32_t>(span.len_);
+    }
+
+    // 단일 consumer 전용
+    int32_t release(BufferSpan& span) override {
+        Node& slot = buf_[span.idx_ & (size_ - 1)];
+        slot.seq.store(span.idx_ + size_, std::memory_order_release);
+        head_.store(span.idx_ + 1, std::memory_order_release);
+        return static_cast<int32_t>(span.len_);
+    }
+
+    // 다중 producer 안전, 연속된 빈 슬롯을 한 번의 CAS로 일괄 점유
+    int32_t enqueue_bulk(const struct iovec* vec, size_t n) override {
+        if (n > size_)
+            n = size_;
+        if (n == 0)
+            return 0;
+
+        while (true) {
+            size_t t = tail_.load(std::memory_order_relaxed);
+            size_t cnt = 0;
+            for (; cnt < n; ++cnt) {
+                size_t seq = buf_[(t + cnt) & (size_ - 1)].seq.load(std::memory_order_acquire);
+                if (seq != t + cnt)
+                    break;
+            }
+            if (cnt == 0) {
+                intptr_t diff = static_cast<intptr_t>(buf_[t & (size_ - 1)].seq.load(std::memory_order_acquire))
+                                - static_cast<intptr_t>(t);
+                if (diff < 0)
+                    return -1; // full
+                continue; // 다른 producer가 아직 처리 중
+            }
+            if (tail_.compare_exchange_weak(
+                    t, t + cnt,
+                    std::memory_order_acq_rel,
+                    std::memory_order_relaxed))
+            {
+                for (size_t i = 0; i < cnt; ++i) {
+                    Node& slot = buf_[(t + i) & (size_ - 1)];
+                    size_t len = vec[i].iov_len;
+                    if (len > MAX_NODE_SIZE)
+                        len = MAX_NODE_SIZE;
+                    std::memcpy(slot.data_, vec[i].iov_base, len);
+                    slot.len_ = static_cast<uint16_t>(len);
+                    slot.seq.store(t + i + 1, std::memory_order_release);
+                }
+                return static_cast<int32_t>(cnt);
+            }
+        }
+    }
+
+    // 단일 consumer 전용
+    int32_t dequeue_bulk(struct iovec* out_vec, size_t max) override {
+        if (max == 0)
+            return 0;
+        size_t h = head_.load(std::memory_order_relaxed);
+        size_t cnt = 0;
+        for (; cnt < max; ++cnt) {
+            Node& slot = buf_[(h + cnt) & (size_ - 1)];
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq != h + cnt + 1)
+                break;
+            if (out_vec[cnt].iov_len > slot.len_)
+                out_vec[cnt].iov_len = slot.len_;
+            std::memcpy(out_vec[cnt].iov_base, slot.data_, out_vec[cnt].iov_len);
+            slot.seq.store(h + cnt + size_, std::memory_order_release);
+        }
+        if (cnt == 0)
+            return -1; // empty
+        head_.store(h + cnt, std::memory_order_release);
+        return static_cast<int32_t>(cnt);
+    }
+};
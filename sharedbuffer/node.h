@@ -0,0 +1,13 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#define MAX_NODE_SIZE 65535
+
+// Vyukov 계열 버퍼(MPSC/SPMC/MPMC) 공용 슬롯
+struct alignas(64) Node {
+    std::atomic<size_t> seq;
+    uint16_t len_;
+    uint8_t data_[MAX_NODE_SIZE];
+};
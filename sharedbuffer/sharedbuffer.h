@@ -1,6 +1,14 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <sys/uio.h>
+
+// 제로카피 접근 시 버퍼 내부 메모리를 가리키는 핸들 (reserve/commit, peek/release 쌍에서 그대로 전달)
+struct BufferSpan {
+    uint8_t* data_; // 버퍼 내부 데이터 위치
+    size_t len_;    // reserve: 기록 가능한 최대 길이, peek: 저장된 데이터 길이
+    size_t idx_;    // 구현체 내부 인덱스 (사용자가 수정하지 말 것)
+};
 
 class SharedBuffer {
 public:
@@ -9,4 +17,18 @@ public:
     virtual int32_t enqueue(const uint8_t* data, size_t len) = 0;
     // 데이터 추출, 성공 시 추출된 길이 반환, 실패 시 -1 반환
     virtual int32_t dequeue(uint8_t* out, size_t len) = 0;
+    // 제로카피 삽입 공간 예약, 성공 시 기록 가능한 길이 반환, 실패 시 -1 반환
+    virtual int32_t reserve(BufferSpan& span, size_t len) = 0;
+    // reserve한 공간에 기록한 len 바이트 게시, 성공 시 게시된 길이 반환
+    virtual int32_t commit(BufferSpan& span, size_t len) = 0;
+    // 제로카피 추출 위치 획득, 성공 시 데이터 길이 반환, 실패 시 -1 반환
+    virtual int32_t peek(BufferSpan& span) = 0;
+    // peek한 데이터 처리 완료 후 공간 반환, 성공 시 반환된 길이 반환
+    virtual int32_t release(BufferSpan& span) = 0;
+    // 데이터 일괄 삽입(슬롯 n개를 한 번에 점유), 성공 시 삽입된 개수 반환, 하나도 삽입하지 못하면 -1 반환
+    virtual int32_t enqueue_bulk(const struct iovec* vec, size_t n) = 0;
+    // 데이터 일괄 추출, out_vec[i].iov_len은 버퍼 크기 → 추출된 길이로 갱신, 성공 시 추출된 개수 반환, 비어 있으면 -1 반환
+    virtual int32_t dequeue_bulk(struct iovec* out_vec, size_t max) = 0;
+    // 여러 스레드가 동시에 dequeue 가능한지 여부 (SPMC / MPMC 링은 true로 재정의)
+    virtual bool is_multi_consumer() const { return false; }
 };
@@ -0,0 +1,144 @@
+/*
+ * ShmRegion: 프로세스 간 공유 메모리 영역 (shm_open / memfd_create + mmap)
+ *
+ * 특징:
+ *  - create(name, len): name이 있으면 POSIX 공유 메모리(/dev/shm) 생성, nullptr이면 memfd 생성
+ *  - attach(name): 다른 프로세스가 생성한 named 영역에 연결 (크기는 fstat으로 확인)
+ *  - attach_fd(fd): fork 상속 또는 SCM_RIGHTS로 전달받은 fd(memfd 포함)에 연결
+ *  - 생성한 쪽(owner)이 파괴될 때 shm_unlink 수행, 연결한 쪽은 munmap/close만 수행
+ *  - 매핑 주소는 프로세스마다 다를 수 있으므로 영역 내부에는 포인터가 아닌 오프셋만 저장해야 함
+ *
+ * 주의:
+ *  - 실패 시 [ERROR] 로그 출력 후 false 반환
+ *  - 복사 불가, 한 객체는 하나의 매핑만 관리
+ */
+
+#pragma once
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+class ShmRegion {
+private:
+    void* addr_;
+    size_t len_;
+    int fd_;
+    std::string name_;
+    bool owner_;
+public:
+    ShmRegion() : addr_(nullptr), len_(0), fd_(-1), owner_(false) {}
+    ShmRegion(const ShmRegion&) = delete;
+    ShmRegion& operator=(const ShmRegion&) = delete;
+    ~ShmRegion() { close_region(); }
+
+    // 새 영역 생성 (name == nullptr 이면 memfd)
+    bool create(const char* name, size_t len) {
+        if (addr_ != nullptr) {
+            std::cerr << "[ERROR] already mapped region "
+            << "(ShmRegion::create) " << '\n';
+            return false;
+        }
+        int fd;
+        if (name != nullptr) {
+            fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) {
+                std::cerr << "[ERROR] shm_open(" << name << ") : " << strerror(errno) << " "
+                << "(ShmRegion::create) " << '\n';
+                return false;
+            }
+            name_ = name;
+            owner_ = true;
+        } else {
+            fd = memfd_create("sharedbuffer", MFD_CLOEXEC);
+            if (fd < 0) {
+                std::cerr << "[ERROR] memfd_create : " << strerror(errno) << " "
+                << "(ShmRegion::create) " << '\n';
+                return false;
+            }
+        }
+        fd_ = fd;
+        if (ftruncate(fd_, static_cast<off_t>(len)) != 0) {
+            std::cerr << "[ERROR] ftruncate : " << strerror(errno) << " "
+            << "(ShmRegion::create) " << '\n';
+            close_region();
+            return false;
+        }
+        return map(len);
+    }
+
+    // 다른 프로세스가 생성한 named 영역에 연결
+    bool attach(const char* name) {
+        if (addr_ != nullptr) {
+            std::cerr << "[ERROR] already mapped region "
+            << "(ShmRegion::attach) " << '\n';
+            return false;
+        }
+        int fd = shm_open(name, O_RDWR, 0600);
+        if (fd < 0) {
+            std::cerr << "[ERROR] shm_open(" << name << ") : " << strerror(errno) << " "
+            << "(ShmRegion::attach) " << '\n';
+            return false;
+        }
+        return attach_fd(fd);
+    }
+
+    // 전달받은 fd에 연결 (fd 소유권을 가져감)
+    bool attach_fd(int fd) {
+        if (addr_ != nullptr) {
+            std::cerr << "[ERROR] already mapped region "
+            << "(ShmRegion::attach_fd) " << '\n';
+            return false;
+        }
+        fd_ = fd;
+        struct stat st;
+        if (fstat(fd_, &st) != 0) {
+            std::cerr << "[ERROR] fstat : " << strerror(errno) << " "
+            << "(ShmRegion::attach_fd) " << '\n';
+            close_region();
+            return false;
+        }
+        return map(static_cast<size_t>(st.st_size));
+    }
+
+    void close_region() {
+        if (addr_ != nullptr) {
+            munmap(addr_, len_);
+            addr_ = nullptr;
+            len_ = 0;
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+        if (owner_) {
+            shm_unlink(name_.c_str());
+            owner_ = false;
+        }
+        name_.clear();
+    }
+
+    void* get_addr() const { return addr_; }
+    size_t get_len() const { return len_; }
+    int get_fd() const { return fd_; }
+
+private:
+    bool map(size_t len) {
+        void* addr = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (addr == MAP_FAILED) {
+            std::cerr << "[ERROR] mmap : " << strerror(errno) << " "
+            << "(ShmRegion::map) " << '\n';
+            close_region();
+            return false;
+        }
+        addr_ = addr;
+        len_ = len;
+        return true;
+    }
+};
@@ -10,12 +10,16 @@
  *  - false sharing 방지를 위한 64바이트 정렬 적용
  *  - payload는 최대 MAX_NODE_SIZE 바이트까지 저장 가능
  *  - & mask 연산 사용 mask = size - 1 
+ *  - reserve()/commit(), peek()/release()로 슬롯 메모리에 직접 쓰고 읽는 제로카피 경로 제공
+ *  - enqueue_bulk()는 한 번의 tail store로, dequeue_bulk()는 연속 슬롯 N개를 한 번의 CAS로 처리
+ *  - AllocPolicy로 링 메모리의 huge page(THP/2MiB/1GiB) 및 NUMA 노드 바인딩/prefault 지정 가능
  *
  * 주의:
  *  - enqueue()는 단일 producer만 호출해야 하며, 복수 producer 동시 호출 시 동작이 보장되지 않는다.
  *  - 경쟁 상황에서 busy-spin(continue 루프)이 발생할 수 있으며,
  *    필요 시 _mm_pause() 또는 std::this_thread::yield() 삽입 권장.
  *  - 큐가 파괴될 때는 모든 producer / consumer 스레드가 종료된 상태여야 한다.
+ *  - reserve()는 commit()과, peek()은 release()와 반드시 짝을 맞춰 호출해야 한다.
  */
 
 #pragma once
@@ -28,23 +32,17 @@
 #include <cassert>
 #include <memory>
 #include "sharedbuffer.h"
-
-#define MAX_NODE_SIZE 65535
-
-struct alignas(64) Node {
-    std::atomic<size_t> seq;
-    uint16_t len_;
-    uint8_t data_[MAX_NODE_SIZE];
-};
+#include "bufferalloc.h"
+#include "node.h"
 
 class SPMCLockFreeBuffer : public SharedBuffer{
 private:
     size_t size_;
-    std::unique_ptr<Node[]> buf_;
+    BufferPtr<Node> buf_;
     alignas(64) std::atomic<size_t> head_;
     alignas(64) std::atomic<size_t> tail_;
 public:
-    SPMCLockFreeBuffer(size_t size): head_(0), tail_(0)
+    SPMCLockFreeBuffer(size_t size, const AllocPolicy& policy = AllocPolicy()): head_(0), tail_(0)
     {
         if (size < 2) size = 2;
         // 2의 제곱이 아닐 경우 상위 제곱으로 보정
@@ -55,9 +53,12 @@ public:
             size = cap;
         }
         size_ = size;
-        buf_ = std::make_unique<Node[]>(size_);
+        buf_ = make_buffer<Node>(size_, policy);
         for (size_t i = 0; i < size_; ++i) buf_[i].seq.store(i, std::memory_order_relaxed);
     }
+    // 다중 consumer 지원 (SignalBuffer BACKPRESSURE_DROP_OLDEST 사용 가능)
+    bool is_multi_consumer() const override{ return true; }
+
     // 단일 producer만 호출해야 함
     int32_t enqueue(const uint8_t* data, size_t len) override{
         if(len > MAX_NODE_SIZE) len = MAX_NODE_SIZE;
@@ -98,4 +99,112 @@ public:
             }
         }
     }
+    // 단일 producer만 호출해야 함
+    int32_t reserve(BufferSpan& span, size_t len) override{
+        if(len > MAX_NODE_SIZE) len = MAX_NODE_SIZE;
+        size_t t = tail_.load(std::memory_order_relaxed);
+        Node& slot = buf_[t & (size_ - 1)];
+        size_t seq = slot.seq.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(t);
+        if (diff != 0)
+            return -1; // full
+        span.data_ = slot.data_;
+        span.len_ = len;
+        span.idx_ = t;
+        return static_cast<int32_t>(len);
+    }
+    // 단일 producer만 호출해야 함
+    int32_t commit(BufferSpan& span, size_t len) override{
+        if(len > span.len_) len = span.len_;
+        Node& slot = buf_[span.idx_ & (size_ - 1)];
+        slot.len_ = static_cast<uint16_t>(len);
+        slot.seq.store(span.idx_ + 1, std::memory_order_release);
+        tail_.store(span.idx_ + 1, std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+    // 복수 consumer 가능
+    int32_t peek(BufferSpan& span) override{
+        while (true) {
+            size_t h = head_.load(std::memory_order_relaxed);
+            Node& slot = buf_[h & (size_ - 1)];
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(h + 1);
+            if (diff < 0)return -1; // empty
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(h, h + 1,std::memory_order_acquire, std::memory_order_relaxed)) {
+                    span.data_ = slot.data_;
+                    span.len_ = slot.len_;
+                    span.idx_ = h;
+                    return static_cast<int32_t>(span.len_);
+                }
+            } else {
+                continue;
+            }
+        }
+    }
+    // 복수 consumer 가능
+    int32_t release(BufferSpan& span) override{
+        Node& slot = buf_[span.idx_ & (size_ - 1)];
+        slot.seq.store(span.idx_ + size_, std::memory_order_release);
+        return static_cast<int32_t>(span.len_);
+    }
+    // 단일 producer만 호출해야 함
+    int32_t enqueue_bulk(const struct iovec* vec, size_t n) override{
+        if (n == 0)
+            return 0;
+        size_t t = tail_.load(std::memory_order_relaxed);
+        size_t cnt = 0;
+        for (; cnt < n; ++cnt) {
+            Node& slot = buf_[(t + cnt) & (size_ - 1)];
+            if (slot.seq.load(std::memory_order_acquire) != t + cnt)
+                break; // full
+            size_t len = vec[cnt].iov_len;
+            if(len > MAX_NODE_SIZE) len = MAX_NODE_SIZE;
+            std::memcpy(slot.data_, vec[cnt].iov_base, len);
+            slot.len_ = static_cast<uint16_t>(len);
+            slot.seq.store(t + cnt + 1, std::memory_order_release);
+        }
+        if (cnt == 0)
+            return -1; // full
+        tail_.store(t + cnt, std::memory_order_release);
+        return static_cast<int32_t>(cnt);
+    }
+    // 복수 consumer 가능, 연속된 데이터 슬롯을 한 번의 CAS로 일괄 점유
+    int32_t dequeue_bulk(struct iovec* out_vec, size_t max) override {
+        if (max > size_)
+            max = size_;
+        if (max == 0)
+            return 0;
+
+        while (true) {
+            size_t h = head_.load(std::memory_order_relaxed);
+            size_t cnt = 0;
+            for (; cnt < max; ++cnt) {
+                size_t seq = buf_[(h + cnt) & (size_ - 1)].seq.load(std::memory_order_acquire);
+                if (seq != h + cnt + 1)
+                    break;
+            }
+            if (cnt == 0) {
+                intptr_t diff = static_cast<intptr_t>(buf_[h & (size_ - 1)].seq.load(std::memory_order_acquire))
+                                - static_cast<intptr_t>(h + 1);
+                if (diff < 0)
+                    return -1; // empty
+                continue; // 다른 consumer가 이미 가져감
+            }
+            if (head_.compare_exchange_weak(
+                    h, h + cnt,
+                    std::memory_order_acquire,
+                    std::memory_order_relaxed))
+            {
+                for (size_t i = 0; i < cnt; ++i) {
+                    Node& slot = buf_[(h + i) & (size_ - 1)];
+                    if (out_vec[i].iov_len > slot.len_)
+                        out_vec[i].iov_len = slot.len_;
+                    std::memcpy(out_vec[i].iov_base, slot.data_, out_vec[i].iov_len);
+                    slot.seq.store(h + i + size_, std::memory_order_release);
+                }
+                return static_cast<int32_t>(cnt);
+            }
+        }
+    }
 };
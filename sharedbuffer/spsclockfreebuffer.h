@@ -7,8 +7,13 @@
  *  - head / tail 인덱스만 원자적으로 관리 → 최소한의 메모리 배리어 사용
  *  - acquire/release 오더링을 통해 CPU 아키텍처 간 일관성 유지
  *  - 2의 제곱 크기 버퍼와 비트 마스크 인덱싱으로 모듈로(mod) 연산 제거
- *  - false sharing 방지를 위한 64바이트 정렬 권장
+ *  - head / tail을 서로 다른 64바이트 캐시 라인에 배치하여 false sharing 방지
+ *  - producer는 tail_, consumer는 head_의 로컬 사본(cache)을 유지하고
+ *    큐가 가득 차 보이거나 비어 보일 때만 상대 인덱스를 다시 읽음 → 코어 간 캐시 라인 핑퐁 최소화
  *  - & mask 연산 사용 mask = size - 1 
+ *  - reserve()/commit(), peek()/release()로 슬롯 메모리에 직접 쓰고 읽는 제로카피 경로 제공
+ *  - enqueue_bulk()/dequeue_bulk()는 N개를 처리한 뒤 인덱스를 한 번만 store
+ *  - AllocPolicy로 링 메모리의 huge page(THP/2MiB/1GiB) 및 NUMA 노드 바인딩/prefault 지정 가능
  *
  * 주의:
  *  - producer 및 consumer 스레드는 각각 단일해야 한다.
@@ -27,6 +32,7 @@
 #include <vector>
 #include <memory>
 #include "sharedbuffer.h"
+#include "bufferalloc.h"
 
 #define MAX_SLOT_SIZE 65535
 
@@ -37,12 +43,14 @@ struct Slot {
 
 class SPSCLockFreeBuffer : public SharedBuffer{
 private:
-    std::unique_ptr<Slot[]> buf_;
-    std::atomic<size_t> head_;
-    std::atomic<size_t> tail_;
+    BufferPtr<Slot> buf_;
     size_t size_;
+    alignas(64) std::atomic<size_t> head_; // producer 전용 쓰기
+    size_t tail_cache_;                    // producer가 마지막으로 관찰한 tail_
+    alignas(64) std::atomic<size_t> tail_; // consumer 전용 쓰기
+    size_t head_cache_;                    // consumer가 마지막으로 관찰한 head_
 public:
-    SPSCLockFreeBuffer(size_t size): head_(0),tail_(0){
+    SPSCLockFreeBuffer(size_t size, const AllocPolicy& policy = AllocPolicy()): head_(0),tail_cache_(0),tail_(0),head_cache_(0){
         if (size < 2) size = 2;
         if ((size & (size - 1)) != 0) {// 2의 제곱이 아닐 경우 상위 제곱으로 보정
             size_t cap = 1;
@@ -51,13 +59,16 @@ public:
             size = cap;
         }
         size_ = size;
-        buf_=std::make_unique<Slot[]>(size_);
+        buf_=make_buffer<Slot>(size_, policy);
     }
     int32_t enqueue(const uint8_t* data, size_t len) override{
         if(len > MAX_SLOT_SIZE) len = MAX_SLOT_SIZE;
         size_t head = head_.load(std::memory_order_relaxed);
         size_t next = (head + 1) & (size_ - 1);
-        if (next == tail_.load(std::memory_order_acquire)) return -1; // full
+        if (next == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (next == tail_cache_) return -1; // full
+        }
         std::memcpy(buf_[head].data_, data, len);
         buf_[head].len_ = static_cast<uint16_t>(len);
         head_.store(next, std::memory_order_release);
@@ -65,10 +76,83 @@ public:
     }
     int32_t dequeue(uint8_t* out, size_t len) override{
         size_t tail = tail_.load(std::memory_order_relaxed);
-        if (tail == head_.load(std::memory_order_acquire)) return -1; // empty
+        if (tail == head_cache_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail == head_cache_) return -1; // empty
+        }
         if(len > buf_[tail].len_) len = buf_[tail].len_;
         std::memcpy(out,buf_[tail].data_,len);
         tail_.store((tail + 1) & (size_ - 1), std::memory_order_release);
         return static_cast<int32_t>(len);
     }
-};
\ No newline at end of file
+    int32_t reserve(BufferSpan& span, size_t len) override{
+        if(len > MAX_SLOT_SIZE) len = MAX_SLOT_SIZE;
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t next = (head + 1) & (size_ - 1);
+        if (next == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (next == tail_cache_) return -1; // full
+        }
+        span.data_ = buf_[head].data_;
+        span.len_ = len;
+        span.idx_ = head;
+        return static_cast<int32_t>(len);
+    }
+    int32_t commit(BufferSpan& span, size_t len) override{
+        if(len > span.len_) len = span.len_;
+        buf_[span.idx_].len_ = static_cast<uint16_t>(len);
+        head_.store((span.idx_ + 1) & (size_ - 1), std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+    int32_t peek(BufferSpan& span) override{
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_cache_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail == head_cache_) return -1; // empty
+        }
+        span.data_ = buf_[tail].data_;
+        span.len_ = buf_[tail].len_;
+        span.idx_ = tail;
+        return static_cast<int32_t>(span.len_);
+    }
+    int32_t release(BufferSpan& span) override{
+        tail_.store((span.idx_ + 1) & (size_ - 1), std::memory_order_release);
+        return static_cast<int32_t>(span.len_);
+    }
+    int32_t enqueue_bulk(const struct iovec* vec, size_t n) override{
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t room = (tail_cache_ - head - 1) & (size_ - 1);
+        if (room < n) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            room = (tail_cache_ - head - 1) & (size_ - 1);
+            if (room == 0) return -1; // full
+        }
+        if (n > room) n = room;
+        for (size_t i = 0; i < n; ++i) {
+            size_t len = vec[i].iov_len;
+            if(len > MAX_SLOT_SIZE) len = MAX_SLOT_SIZE;
+            std::memcpy(buf_[head].data_, vec[i].iov_base, len);
+            buf_[head].len_ = static_cast<uint16_t>(len);
+            head = (head + 1) & (size_ - 1);
+        }
+        head_.store(head, std::memory_order_release);
+        return static_cast<int32_t>(n);
+    }
+    int32_t dequeue_bulk(struct iovec* out_vec, size_t max) override{
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t avail = (head_cache_ - tail) & (size_ - 1);
+        if (avail < max) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            avail = (head_cache_ - tail) & (size_ - 1);
+            if (avail == 0) return -1; // empty
+        }
+        if (max > avail) max = avail;
+        for (size_t i = 0; i < max; ++i) {
+            if(out_vec[i].iov_len > buf_[tail].len_) out_vec[i].iov_len = buf_[tail].len_;
+            std::memcpy(out_vec[i].iov_base, buf_[tail].data_, out_vec[i].iov_len);
+            tail = (tail + 1) & (size_ - 1);
+        }
+        tail_.store(tail, std::memory_order_release);
+        return static_cast<int32_t>(max);
+    }
+};
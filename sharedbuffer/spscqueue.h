@@ -0,0 +1,93 @@
+/*
+ * Lamport Bounded SPSC Lock-Free Queue (Typed / Compile-Time Size Version)
+ *
+ * 특징:
+ *  - 단일 producer, 단일 consumer 환경에서 완전한 wait-free 동작 보장
+ *  - 바이트 직렬화 없이 T를 이동(move)으로 저장 → 포인터, 디스크립터, 작은 구조체 전달에 적합
+ *  - 용량 N은 컴파일 타임 상수(2의 제곱) → 인덱스 mask가 상수로 접힘
+ *  - 가상 함수 없는 final 템플릿 → 호출이 인라인으로 devirtualize 됨
+ *  - head / tail을 서로 다른 64바이트 캐시 라인에 배치하고, 상대 인덱스의 로컬 사본(cache)은
+ *    가득 차 보이거나 비어 보일 때만 갱신 → 코어 간 캐시 라인 핑퐁 최소화
+ *  - head / tail은 단조 증가 카운터이므로 N개 슬롯을 모두 사용 가능
+ *
+ * 주의:
+ *  - producer 및 consumer 스레드는 각각 단일해야 한다.
+ *  - 큐가 가득 찼을 때 enqueue()는 false를 반환하며, 인자는 이동되지 않는다.
+ *  - 큐가 비었을 때 dequeue()는 false를 반환한다.
+ *  - 파괴 시 남아 있는 요소는 소멸자가 호출된다.
+ *
+ * 사용 예시:
+ *  SPSCQueue<Packet*, 1024> q;
+ *  q.enqueue(pkt);
+ *  Packet* out;
+ *  if (q.dequeue(out)) { ... }
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T, size_t N>
+class SPSCQueue final {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SPSCQueue capacity must be a power of two");
+    static_assert(std::is_nothrow_move_constructible<T>::value, "SPSCQueue requires nothrow move");
+    static constexpr size_t MASK = N - 1;
+
+    struct Slot {
+        alignas(T) unsigned char storage_[sizeof(T)];
+        T* ptr() { return std::launder(reinterpret_cast<T*>(storage_)); }
+    };
+
+private:
+    Slot buf_[N];
+    alignas(64) std::atomic<size_t> head_; // producer 전용 쓰기
+    size_t tail_cache_;                    // producer가 마지막으로 관찰한 tail_
+    alignas(64) std::atomic<size_t> tail_; // consumer 전용 쓰기
+    size_t head_cache_;                    // consumer가 마지막으로 관찰한 head_
+public:
+    SPSCQueue() : head_(0), tail_cache_(0), tail_(0), head_cache_(0) {}
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+    ~SPSCQueue() {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail)
+            buf_[tail & MASK].ptr()->~T();
+    }
+
+    template <typename... Args>
+    inline bool emplace(Args&&... args) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_cache_ == N) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head - tail_cache_ == N) return false; // full
+        }
+        new (buf_[head & MASK].storage_) T(std::forward<Args>(args)...);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    inline bool enqueue(T&& item) { return emplace(std::move(item)); }
+    inline bool enqueue(const T& item) { return emplace(item); }
+
+    inline bool dequeue(T& out) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_cache_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail == head_cache_) return false; // empty
+        }
+        T* item = buf_[tail & MASK].ptr();
+        out = std::move(*item);
+        item->~T();
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 근사치 (동시 접근 중에는 참고용)
+    inline size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    static constexpr size_t capacity() { return N; }
+};
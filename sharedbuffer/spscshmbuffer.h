@@ -0,0 +1,223 @@
+/*
+ * Lamport Bounded SPSC Lock-Free Queue (Shared Memory / Cross-Process Version)
+ *
+ * 특징:
+ *  - SPSCLockFreeBuffer와 동일한 알고리즘을 프로세스 간 공유 메모리(ShmRegion) 위에서 수행
+ *  - head / tail 및 슬롯 전체가 매핑 내부에 존재 → 캡처 프로세스와 분석 프로세스가 직접 데이터 교환
+ *  - 위치 독립(position-independent) 레이아웃: 매핑 내부에는 포인터 없이 크기/오프셋만 저장
+ *      * [SPSCShmHeader][slot 0][slot 1]...[slot size-1]
+ *      * slot = 8바이트 len + payload, slot 간격(stride)은 64바이트 단위로 정렬
+ *  - slot_size(슬롯 payload 최대 길이)를 생성 시 지정 가능 → 공유 메모리 사용량 절감
+ *  - producer/consumer 로컬 캐시 인덱스는 각 프로세스의 객체에만 존재
+ *  - reserve()/commit(), peek()/release(), enqueue_bulk()/dequeue_bulk() 모두 지원
+ *
+ * 사용 방법:
+ *  - 생성 프로세스: create(name, size, slot_size) → 헤더 초기화 후 magic 기록
+ *  - 연결 프로세스: attach(name) 또는 attach_fd(fd) → magic/레이아웃 확인 후 사용
+ *  - name이 nullptr이면 memfd로 생성되며, get_fd()로 얻은 fd를 fork 또는 SCM_RIGHTS로 전달
+ *
+ * 주의:
+ *  - 프로세스 전체를 통틀어 producer와 consumer는 각각 단일해야 한다.
+ *  - create()/attach() 성공 전에는 enqueue/dequeue를 호출하지 말 것.
+ *  - 생성 프로세스가 파괴되면 이름은 unlink 되지만, 이미 연결된 프로세스의 매핑은 유지된다.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include "sharedbuffer.h"
+#include "shmregion.h"
+
+#define MAX_SHM_SLOT_SIZE 65535
+#define SPSC_SHM_MAGIC 0x5350534353484d31ULL // "SPSCSHM1"
+#define SPSC_SHM_SLOT_HDR 8
+
+struct alignas(64) SPSCShmHeader {
+    std::atomic<uint64_t> magic_; // 초기화 완료 표시 (마지막에 release store)
+    uint64_t size_;               // 슬롯 개수 (2의 제곱)
+    uint64_t slot_size_;          // 슬롯 payload 최대 길이
+    uint64_t stride_;             // 슬롯 간 바이트 간격
+    alignas(64) std::atomic<uint64_t> head_; // producer 전용 쓰기
+    alignas(64) std::atomic<uint64_t> tail_; // consumer 전용 쓰기
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory atomics must be address-free");
+
+class SPSCShmBuffer : public SharedBuffer{
+private:
+    ShmRegion region_;
+    SPSCShmHeader* hdr_;
+    uint8_t* slots_;
+    size_t size_;
+    size_t slot_size_;
+    size_t stride_;
+    size_t tail_cache_; // producer가 마지막으로 관찰한 tail_
+    size_t head_cache_; // consumer가 마지막으로 관찰한 head_
+public:
+    SPSCShmBuffer() : hdr_(nullptr), slots_(nullptr), size_(0), slot_size_(0), stride_(0), tail_cache_(0), head_cache_(0) {}
+
+    // 공유 메모리 생성 및 초기화 (name == nullptr 이면 memfd)
+    bool create(const char* name, size_t size, size_t slot_size = MAX_SHM_SLOT_SIZE) {
+        if (size < 2) size = 2;
+        if ((size & (size - 1)) != 0) {// 2의 제곱이 아닐 경우 상위 제곱으로 보정
+            size_t cap = 1;
+            while (cap < size)
+                cap <<= 1;
+            size = cap;
+        }
+        if (slot_size > MAX_SHM_SLOT_SIZE) slot_size = MAX_SHM_SLOT_SIZE;
+        size_t stride = (SPSC_SHM_SLOT_HDR + slot_size + 63) & ~static_cast<size_t>(63);
+        if (!region_.create(name, sizeof(SPSCShmHeader) + size * stride)) return false;
+        SPSCShmHeader* hdr = new (region_.get_addr()) SPSCShmHeader();
+        hdr->size_ = size;
+        hdr->slot_size_ = slot_size;
+        hdr->stride_ = stride;
+        hdr->head_.store(0, std::memory_order_relaxed);
+        hdr->tail_.store(0, std::memory_order_relaxed);
+        hdr->magic_.store(SPSC_SHM_MAGIC, std::memory_order_release);
+        return bind();
+    }
+    // 다른 프로세스가 생성한 named 영역에 연결
+    bool attach(const char* name) {
+        if (!region_.attach(name)) return false;
+        return bind();
+    }
+    // 전달받은 fd에 연결
+    bool attach_fd(int fd) {
+        if (!region_.attach_fd(fd)) return false;
+        return bind();
+    }
+    int get_fd() const { return region_.get_fd(); }
+
+    int32_t enqueue(const uint8_t* data, size_t len) override{
+        if(len > slot_size_) len = slot_size_;
+        size_t head = hdr_->head_.load(std::memory_order_relaxed);
+        size_t next = (head + 1) & (size_ - 1);
+        if (next == tail_cache_) {
+            tail_cache_ = hdr_->tail_.load(std::memory_order_acquire);
+            if (next == tail_cache_) return -1; // full
+        }
+        std::memcpy(slot_data(head), data, len);
+        slot_len(head) = len;
+        hdr_->head_.store(next, std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+    int32_t dequeue(uint8_t* out, size_t len) override{
+        size_t tail = hdr_->tail_.load(std::memory_order_relaxed);
+        if (tail == head_cache_) {
+            head_cache_ = hdr_->head_.load(std::memory_order_acquire);
+            if (tail == head_cache_) return -1; // empty
+        }
+        if(len > slot_len(tail)) len = slot_len(tail);
+        std::memcpy(out, slot_data(tail), len);
+        hdr_->tail_.store((tail + 1) & (size_ - 1), std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+    int32_t reserve(BufferSpan& span, size_t len) override{
+        if(len > slot_size_) len = slot_size_;
+        size_t head = hdr_->head_.load(std::memory_order_relaxed);
+        size_t next = (head + 1) & (size_ - 1);
+        if (next == tail_cache_) {
+            tail_cache_ = hdr_->tail_.load(std::memory_order_acquire);
+            if (next == tail_cache_) return -1; // full
+        }
+        span.data_ = slot_data(head);
+        span.len_ = len;
+        span.idx_ = head;
+        return static_cast<int32_t>(len);
+    }
+    int32_t commit(BufferSpan& span, size_t len) override{
+        if(len > span.len_) len = span.len_;
+        slot_len(span.idx_) = len;
+        hdr_->head_.store((span.idx_ + 1) & (size_ - 1), std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+    int32_t peek(BufferSpan& span) override{
+        size_t tail = hdr_->tail_.load(std::memory_order_relaxed);
+        if (tail == head_cache_) {
+            head_cache_ = hdr_->head_.load(std::memory_order_acquire);
+            if (tail == head_cache_) return -1; // empty
+        }
+        span.data_ = slot_data(tail);
+        span.len_ = slot_len(tail);
+        span.idx_ = tail;
+        return static_cast<int32_t>(span.len_);
+    }
+    int32_t release(BufferSpan& span) override{
+        hdr_->tail_.store((span.idx_ + 1) & (size_ - 1), std::memory_order_release);
+        return static_cast<int32_t>(span.len_);
+    }
+    int32_t enqueue_bulk(const struct iovec* vec, size_t n) override{
+        size_t head = hdr_->head_.load(std::memory_order_relaxed);
+        size_t room = (tail_cache_ - head - 1) & (size_ - 1);
+        if (room < n) {
+            tail_cache_ = hdr_->tail_.load(std::memory_order_acquire);
+            room = (tail_cache_ - head - 1) & (size_ - 1);
+            if (room == 0) return -1; // full
+        }
+        if (n > room) n = room;
+        for (size_t i = 0; i < n; ++i) {
+            size_t len = vec[i].iov_len;
+            if(len > slot_size_) len = slot_size_;
+            std::memcpy(slot_data(head), vec[i].iov_base, len);
+            slot_len(head) = len;
+            head = (head + 1) & (size_ - 1);
+        }
+        hdr_->head_.store(head, std::memory_order_release);
+        return static_cast<int32_t>(n);
+    }
+    int32_t dequeue_bulk(struct iovec* out_vec, size_t max) override{
+        size_t tail = hdr_->tail_.load(std::memory_order_relaxed);
+        size_t avail = (head_cache_ - tail) & (size_ - 1);
+        if (avail < max) {
+            head_cache_ = hdr_->head_.load(std::memory_order_acquire);
+            avail = (head_cache_ - tail) & (size_ - 1);
+            if (avail == 0) return -1; // empty
+        }
+        if (max > avail) max = avail;
+        for (size_t i = 0; i < max; ++i) {
+            if(out_vec[i].iov_len > slot_len(tail)) out_vec[i].iov_len = slot_len(tail);
+            std::memcpy(out_vec[i].iov_base, slot_data(tail), out_vec[i].iov_len);
+            tail = (tail + 1) & (size_ - 1);
+        }
+        hdr_->tail_.store(tail, std::memory_order_release);
+        return static_cast<int32_t>(max);
+    }
+private:
+    // 다른 프로세스가 기록한 헤더 검증: 2의 제곱 size, 슬롯 겹침 없음, size * stride가 매핑 안에 들어감 (곱셈 overflow 없이 비교)
+    static bool valid_layout(const SPSCShmHeader* hdr, size_t avail) {
+        if (hdr->size_ < 2 || (hdr->size_ & (hdr->size_ - 1)) != 0) return false;
+        if (hdr->slot_size_ > MAX_SHM_SLOT_SIZE) return false;
+        if (hdr->stride_ < SPSC_SHM_SLOT_HDR + hdr->slot_size_ || hdr->stride_ % sizeof(uint64_t) != 0) return false;
+        return hdr->size_ <= avail / hdr->stride_;
+    }
+    // 매핑된 영역의 헤더 검증 후 로컬 레이아웃 정보 설정
+    bool bind() {
+        SPSCShmHeader* hdr = static_cast<SPSCShmHeader*>(region_.get_addr());
+        if (region_.get_len() < sizeof(SPSCShmHeader)
+            || hdr->magic_.load(std::memory_order_acquire) != SPSC_SHM_MAGIC
+            || !valid_layout(hdr, region_.get_len() - sizeof(SPSCShmHeader))) {
+            std::cerr << "[ERROR] invalid shared memory layout "
+            << "(SPSCShmBuffer::bind) " << '\n';
+            region_.close_region();
+            return false;
+        }
+        hdr_ = hdr;
+        slots_ = reinterpret_cast<uint8_t*>(hdr) + sizeof(SPSCShmHeader);
+        size_ = hdr->size_;
+        slot_size_ = hdr->slot_size_;
+        stride_ = hdr->stride_;
+        tail_cache_ = hdr->tail_.load(std::memory_order_acquire);
+        head_cache_ = hdr->head_.load(std::memory_order_acquire);
+        return true;
+    }
+    inline uint64_t& slot_len(size_t idx) {
+        return *reinterpret_cast<uint64_t*>(slots_ + idx * stride_);
+    }
+    inline uint8_t* slot_data(size_t idx) {
+        return slots_ + idx * stride_ + SPSC_SHM_SLOT_HDR;
+    }
+};
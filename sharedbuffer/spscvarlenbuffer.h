@@ -0,0 +1,214 @@
+/*
+ * Lamport Bounded SPSC Lock-Free Variable-Length Record Ring (Byte Buffer Version)
+ *
+ * 특징:
+ *  - 단일 producer, 단일 consumer 환경에서 완전한 wait-free 동작 보장
+ *  - 고정 크기 슬롯(MAX_SLOT_SIZE) 대신 하나의 연속된 바이트 링에 가변 길이 레코드를 저장
+ *      * 레코드 = 8바이트 헤더(len) + 8바이트 단위로 패딩된 payload
+ *      * 64바이트 패킷은 72바이트만 차지 → 메모리/캐시 사용량이 실제 트래픽에 비례
+ *  - 링 끝에 레코드가 들어가지 않으면 남은 공간을 패딩 레코드(VARLEN_PAD)로 채우고 처음으로 되감음
+ *  - head / tail은 단조 증가하는 바이트 오프셋, & mask 연산으로 위치 계산 (mask = size - 1)
+ *  - acquire/release 오더링을 통해 CPU 아키텍처 간 일관성 유지
+ *  - head / tail을 서로 다른 64바이트 캐시 라인에 배치하고, 상대 인덱스의 로컬 사본(cache)은
+ *    공간이 부족해 보이거나 비어 보일 때만 갱신 → 코어 간 캐시 라인 핑퐁 최소화
+ *  - SharedBuffer 인터페이스(enqueue/dequeue)를 그대로 따르므로 기존 SignalBuffer와 함께 사용 가능
+ *  - reserve()/commit(), peek()/release()로 링 메모리에 직접 쓰고 읽는 제로카피 경로 제공
+ *      * reserve(len)은 len 바이트의 연속 공간을 확보하며, commit()에서 실제 기록 길이만큼만 링을 소비
+ *  - enqueue_bulk()/dequeue_bulk()는 상대 인덱스를 한 번 읽고 N개를 처리한 뒤 인덱스를 한 번만 store
+ *  - AllocPolicy로 링 메모리의 huge page(THP/2MiB/1GiB) 및 NUMA 노드 바인딩/prefault 지정 가능
+ *
+ * 주의:
+ *  - size는 슬롯 개수가 아닌 바이트 용량이며, 2의 제곱으로 보정된다(최소 VARLEN_MIN_SIZE).
+ *  - 레코드 최대 길이는 min(MAX_VARLEN_SIZE, size/2 - 헤더)이며, 초과분은 잘린다.
+ *  - 링이 가득 차면 enqueue()는 -1을 반환하며, 데이터는 버려진다.
+ *  - 절대 SPSC 구조외에는 사용하지 말 것.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include "sharedbuffer.h"
+#include "bufferalloc.h"
+#include "varlen.h"
+
+class SPSCVarLenBuffer : public SharedBuffer{
+private:
+    BufferPtr<uint8_t> buf_;
+    size_t size_;
+    size_t max_len_;
+    alignas(64) std::atomic<size_t> head_; // producer 바이트 오프셋
+    size_t tail_cache_;                    // producer가 마지막으로 관찰한 tail_
+    alignas(64) std::atomic<size_t> tail_; // consumer 바이트 오프셋
+    size_t head_cache_;                    // consumer가 마지막으로 관찰한 head_
+public:
+    SPSCVarLenBuffer(size_t size, const AllocPolicy& policy = AllocPolicy()): head_(0),tail_cache_(0),tail_(0),head_cache_(0){
+        if (size < VARLEN_MIN_SIZE) size = VARLEN_MIN_SIZE;
+        if ((size & (size - 1)) != 0) {// 2의 제곱이 아닐 경우 상위 제곱으로 보정
+            size_t cap = 1;
+            while (cap < size)
+                cap <<= 1;
+            size = cap;
+        }
+        size_ = size;
+        max_len_ = size_ / 2 - VARLEN_HDR_SIZE;
+        if (max_len_ > MAX_VARLEN_SIZE) max_len_ = MAX_VARLEN_SIZE;
+        buf_ = make_buffer<uint8_t>(size_, policy);
+    }
+    int32_t enqueue(const uint8_t* data, size_t len) override{
+        if (len > max_len_) len = max_len_;
+        size_t rec = record_size(len);
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t pos = head & (size_ - 1);
+        size_t contig = size_ - pos;
+        size_t need = (rec > contig) ? contig + rec : rec;
+        if (need > size_ - (head - tail_cache_)) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (need > size_ - (head - tail_cache_)) return -1; // full
+        }
+        if (rec > contig) {// 링 끝 공간을 패딩으로 소진하고 처음부터 기록
+            write_hdr(pos, VARLEN_PAD);
+            head += contig;
+            pos = 0;
+        }
+        write_hdr(pos, static_cast<uint32_t>(len));
+        std::memcpy(&buf_[pos + VARLEN_HDR_SIZE], data, len);
+        head_.store(head + rec, std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+    int32_t dequeue(uint8_t* out, size_t len) override{
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_cache_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail == head_cache_) return -1; // empty
+        }
+        size_t pos = tail & (size_ - 1);
+        uint32_t rec_len = read_hdr(pos);
+        if (rec_len == VARLEN_PAD) {// 패딩 레코드 → 처음으로 되감기 (패딩 뒤에는 항상 실제 레코드가 존재)
+            tail += size_ - pos;
+            pos = 0;
+            rec_len = read_hdr(pos);
+        }
+        if (len > rec_len) len = rec_len;
+        std::memcpy(out, &buf_[pos + VARLEN_HDR_SIZE], len);
+        tail_.store(tail + record_size(rec_len), std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+    int32_t reserve(BufferSpan& span, size_t len) override{
+        if (len > max_len_) len = max_len_;
+        size_t rec = record_size(len);
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t pos = head & (size_ - 1);
+        size_t contig = size_ - pos;
+        size_t need = (rec > contig) ? contig + rec : rec;
+        if (need > size_ - (head - tail_cache_)) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (need > size_ - (head - tail_cache_)) return -1; // full
+        }
+        if (rec > contig) {// 패딩은 commit()에서 head_가 게시될 때 함께 보임
+            write_hdr(pos, VARLEN_PAD);
+            head += contig;
+            pos = 0;
+        }
+        span.data_ = &buf_[pos + VARLEN_HDR_SIZE];
+        span.len_ = len;
+        span.idx_ = head;
+        return static_cast<int32_t>(len);
+    }
+    int32_t commit(BufferSpan& span, size_t len) override{
+        if (len > span.len_) len = span.len_;
+        write_hdr(span.idx_ & (size_ - 1), static_cast<uint32_t>(len));
+        head_.store(span.idx_ + record_size(len), std::memory_order_release);
+        return static_cast<int32_t>(len);
+    }
+    int32_t peek(BufferSpan& span) override{
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_cache_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail == head_cache_) return -1; // empty
+        }
+        size_t pos = tail & (size_ - 1);
+        uint32_t rec_len = read_hdr(pos);
+        if (rec_len == VARLEN_PAD) {
+            tail += size_ - pos;
+            pos = 0;
+            rec_len = read_hdr(pos);
+        }
+        span.data_ = &buf_[pos + VARLEN_HDR_SIZE];
+        span.len_ = rec_len;
+        span.idx_ = tail;
+        return static_cast<int32_t>(rec_len);
+    }
+    int32_t release(BufferSpan& span) override{
+        tail_.store(span.idx_ + record_size(span.len_), std::memory_order_release);
+        return static_cast<int32_t>(span.len_);
+    }
+    int32_t enqueue_bulk(const struct iovec* vec, size_t n) override{
+        if (n == 0)
+            return 0;
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t cnt = 0;
+        for (; cnt < n; ++cnt) {
+            size_t len = vec[cnt].iov_len;
+            if (len > max_len_) len = max_len_;
+            size_t rec = record_size(len);
+            size_t pos = head & (size_ - 1);
+            size_t contig = size_ - pos;
+            size_t need = (rec > contig) ? contig + rec : rec;
+            if (need > size_ - (head - tail_cache_)) {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (need > size_ - (head - tail_cache_)) break; // full
+            }
+            if (rec > contig) {
+                write_hdr(pos, VARLEN_PAD);
+                head += contig;
+                pos = 0;
+            }
+            write_hdr(pos, static_cast<uint32_t>(len));
+            std::memcpy(&buf_[pos + VARLEN_HDR_SIZE], vec[cnt].iov_base, len);
+            head += rec;
+        }
+        if (cnt == 0) return -1; // full
+        head_.store(head, std::memory_order_release);
+        return static_cast<int32_t>(cnt);
+    }
+    int32_t dequeue_bulk(struct iovec* out_vec, size_t max) override{
+        if (max == 0)
+            return 0;
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t cnt = 0;
+        for (; cnt < max; ++cnt) {
+            if (tail == head_cache_) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (tail == head_cache_) break; // empty
+            }
+            size_t pos = tail & (size_ - 1);
+            uint32_t rec_len = read_hdr(pos);
+            if (rec_len == VARLEN_PAD) {
+                tail += size_ - pos;
+                pos = 0;
+                rec_len = read_hdr(pos);
+            }
+            if (out_vec[cnt].iov_len > rec_len) out_vec[cnt].iov_len = rec_len;
+            std::memcpy(out_vec[cnt].iov_base, &buf_[pos + VARLEN_HDR_SIZE], out_vec[cnt].iov_len);
+            tail += record_size(rec_len);
+        }
+        if (cnt == 0) return -1; // empty
+        tail_.store(tail, std::memory_order_release);
+        return static_cast<int32_t>(cnt);
+    }
+private:
+    static inline size_t record_size(size_t len) {
+        return VARLEN_HDR_SIZE + ((len + VARLEN_ALIGN - 1) & ~static_cast<size_t>(VARLEN_ALIGN - 1));
+    }
+    inline void write_hdr(size_t pos, uint32_t len) {
+        std::memcpy(&buf_[pos], &len, sizeof(len));
+    }
+    inline uint32_t read_hdr(size_t pos) const {
+        uint32_t len;
+        std::memcpy(&len, &buf_[pos], sizeof(len));
+        return len;
+    }
+};
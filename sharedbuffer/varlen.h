@@ -0,0 +1,8 @@
+#pragma once
+#include <cstdint>
+
+#define MAX_VARLEN_SIZE 65535
+#define VARLEN_MIN_SIZE 4096
+#define VARLEN_ALIGN 8
+#define VARLEN_HDR_SIZE 8
+#define VARLEN_PAD UINT32_MAX // 링 끝 잔여 공간을 채우는 패딩 레코드 표시 (헤더 len 자리)
@@ -12,11 +12,19 @@
  *  - 내부 SPMCBuf 원형 버퍼 사용, 단일 다중 프로듀서 enqueue 지원
  *  - atomic flag + wait/notify 로 lost wakeup 방지
  *  - lock-free 구조로 여러 컨슈머 경쟁 가능
+ *  - WaitStrategy로 park 전 spin(pause) → yield 단계 지정 가능 (적응형 spin-then-park)
+ *  - waiters_ 카운트로 wait 중인 컨슈머가 없으면 notify_one 생략
+ *  - std::atomic::wait에는 timeout이 없으므로 dequeue_wait_for()/dequeue_wait_bulk()의 timeout 대기는
+ *    flag를 확인하며 1us부터 최대 1ms까지 지수적으로 늘어나는 sleep으로 대체
+ *  - get_stats()로 enqueue/drop/dequeue/wake/wait/spurious/high-water 통계 조회 (relaxed atomic 카운터)
+ *  - BackpressurePolicy로 링이 가득 찼을 때 동작 지정 (drop-newest / drop-oldest / block / spill)
  *
  * 동작:
- *  - enqueue_wake(): 데이터 enqueue + flag store + notify_one
+ *  - enqueue_wake(): 데이터 enqueue + flag store + (대기자가 있을 때만) notify_one
  *  - wake_all(): 모든 대기 컨슈머 notify
- *  - dequeue_wait(): 데이터 있으면 즉시 반환, 없으면 CAS 후 atomic wait
+ *  - dequeue_wait(): 데이터 있으면 즉시 반환, 없으면 spin → yield → waiters_ 증가 후 CAS + atomic wait
+ *  - dequeue_wait_for(): dequeue_wait()와 동일하나 timeout 경과 시 깨어나 재시도 후 반환
+ *  - dequeue_wait_bulk(): 한 번 깨어난 뒤 준비된 데이터를 일괄 추출
  *
  * 안정성:
  *  - 데이터 폭주, 간헐적 도착 모두 처리 가능
@@ -29,25 +37,23 @@
 #include <iostream>
 #include <atomic>
 #include <cstdint>
+#include <chrono>
+#include <thread>
+#include <algorithm>
 #include "signalbuffer.h"
 
 class AtomicSignalBuffer : public SignalBuffer {
     std::atomic<int> flag_;
     std::atomic<bool> wake_all_flag_;
+    std::atomic<int> waiters_; // atomic wait 중(또는 진입 중)인 컨슈머 수
 public:
-    AtomicSignalBuffer(std::unique_ptr<SharedBuffer> shared_buf) : SignalBuffer(std::move(shared_buf)), flag_(0),wake_all_flag_(false) {}
+    AtomicSignalBuffer(std::unique_ptr<SharedBuffer> shared_buf, const WaitStrategy& wait_strategy = WaitStrategy(),
+        const BackpressurePolicy& backpressure = BackpressurePolicy())
+        : SignalBuffer(std::move(shared_buf), wait_strategy, backpressure), flag_(0),wake_all_flag_(false),waiters_(0) {}
 
     int32_t enqueue_wake(const uint8_t* data, size_t len) override {
-        int32_t n = shared_buf_->enqueue(data, len);
-        if (n >=0) {
-            flag_.store(1, std::memory_order_release);
-            flag_.notify_one();  
-        }
-        else{
-            std::cout << "shared_buf_ is pull " << '\n';
-            flag_.store(1, std::memory_order_release);
-            flag_.notify_one();
-        }
+        int32_t n = enqueue_policy(data, len);
+        signal_one(); // full이어도 컨슈머를 깨워 소비를 재촉
         return n; // -1: full
     }
 
@@ -55,22 +61,45 @@ public:
         wake_all_flag_.store(true,std::memory_order_release);
         flag_.store(1, std::memory_order_release);
         flag_.notify_all();
+        count_wake();
     }
 
-    int32_t dequeue_wait(uint8_t* out, size_t len) override {
-        int32_t n = shared_buf_->dequeue(out, len);
-        if (n >= 0) return n;
+protected:
+    void wait_signal(std::chrono::nanoseconds timeout) override {
         int expected = 1;
         if(wake_all_flag_.load(std::memory_order_acquire)==true){
             flag_.store(1, std::memory_order_release);
             flag_.notify_all();
-            return -1;
+            return;
         }
-        if (!flag_.compare_exchange_strong(expected, 0, std::memory_order_release, std::memory_order_relaxed)) {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        if (!flag_.compare_exchange_strong(expected, 0, std::memory_order_seq_cst, std::memory_order_seq_cst)) {
             // flag가 1이면 0으로 바꾸고 true 반환하고 이것이 반전됨 wait 건너뜀
             // flag가 0이면 0으로 유지하고 false 반환하고 이것이 반전됨 wait 들어감 
-            flag_.wait(0, std::memory_order_acquire);
+            count_wait();
+            if (timeout.count() < 0) {
+                flag_.wait(0, std::memory_order_acquire);
+            } else {
+                auto deadline = std::chrono::steady_clock::now() + timeout;
+                std::chrono::nanoseconds nap = std::chrono::microseconds(1);
+                while (flag_.load(std::memory_order_acquire) == 0) {
+                    auto now = std::chrono::steady_clock::now();
+                    if (now >= deadline) break;
+                    std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(nap, deadline - now));
+                    if (nap < std::chrono::milliseconds(1)) nap *= 2;
+                }
+            }
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    // flag 설정 후 wait 중인 컨슈머가 있을 때만 하나 깨움
+    inline void signal_one() {
+        flag_.store(1, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) > 0) {
+            flag_.notify_one();
+            count_wake();
         }
-        return -1;
     }
 };
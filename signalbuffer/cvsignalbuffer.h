@@ -11,11 +11,19 @@
  *  - flag 기반 wake/notify로 lost wakeup 방지
  *  - enqueue_wake 호출 시 깨어난 컨슈머가 즉시 데이터 처리
  *  - wake_all 호출 시 모든 컨슈머 동시 깨움 가능
+ *  - WaitStrategy로 wait 전 spin(pause) → yield 단계 지정 가능 (적응형 spin-then-park)
+ *  - waiters_ 카운트(mtx_ 보호)로 wait 중인 컨슈머가 없으면 notify_one 생략
+ *  - dequeue_wait_for()/dequeue_wait_bulk()는 cv_.wait_for로 대기 시간 제한
+ *  - get_stats()로 enqueue/drop/dequeue/wake/wait/spurious/high-water 통계 조회 (relaxed atomic 카운터)
+ *  - BackpressurePolicy로 링이 가득 찼을 때 동작 지정 (drop-newest / drop-oldest / block / spill)
  *
  * 동작:
- *  - enqueue_wake(): 데이터 enqueue + flag 설정 + notify_one
+ *  - enqueue_wake(): 데이터 enqueue + flag 설정 + (대기자가 있을 때만) notify_one
  *  - wake_all(): 모든 대기 컨슈머 notify
- *  - dequeue_wait(): 데이터 있으면 즉시 반환, 없으면 while 루프를 통해 flag 확인 후 wait
+ *  - dequeue_wait(): 데이터 있으면 즉시 반환, 없으면 spin → yield → mtx_ 안에서 flag 확인 후 wait
+ *      * flag가 설정되어 있으면 소비(0으로 초기화)하고 wait 건너뜀, 아니면 wait
+ *  - dequeue_wait_for(): dequeue_wait()와 동일하나 timeout 경과 시 깨어나 재시도 후 반환
+ *  - dequeue_wait_bulk(): 한 번 깨어난 뒤 준비된 데이터를 일괄 추출
  *
  * 안정성:
  *  - 데이터 폭주, 간헐적 도착 모두 안전하게 처리 가능
@@ -27,31 +35,23 @@
 #include <mutex>
 #include <condition_variable>
 #include <cstdint>
+#include <chrono>
 #include "signalbuffer.h"
 
 class CVSignalbuffer : public SignalBuffer{
     std::mutex mtx_;
     std::condition_variable cv_;
     uint64_t flag_;
+    uint32_t waiters_; // cv wait 중인 컨슈머 수 (mtx_ 보호)
 
 public:
-    CVSignalbuffer(std::unique_ptr<SharedBuffer> shared_buf) : SignalBuffer(std::move(shared_buf)), flag_(0) {}
+    CVSignalbuffer(std::unique_ptr<SharedBuffer> shared_buf, const WaitStrategy& wait_strategy = WaitStrategy(),
+        const BackpressurePolicy& backpressure = BackpressurePolicy())
+        : SignalBuffer(std::move(shared_buf), wait_strategy, backpressure), flag_(0), waiters_(0) {}
 
     int32_t enqueue_wake(const uint8_t* data, size_t len) override {
-        int32_t n = shared_buf_->enqueue(data, len);
-        if (n >= 0) {
-            std::unique_lock<std::mutex> lock(mtx_);
-            flag_++;
-            lock.unlock();
-            cv_.notify_one();
-        }
-        else{
-            std::cout << "shared_buf_ is pull " << '\n';
-            std::unique_lock<std::mutex> lock(mtx_);
-            flag_++;
-            lock.unlock();
-            cv_.notify_one();
-        }
+        int32_t n = enqueue_policy(data, len);
+        signal_one(); // full이어도 컨슈머를 깨워 소비를 재촉
         return n; // -1: full
     }
 
@@ -60,19 +60,33 @@ public:
         flag_++;
         lock.unlock();
         cv_.notify_all();
+        count_wake();
     }
 
-    int32_t dequeue_wait(uint8_t* out, size_t len) override {
-        int32_t n = shared_buf_->dequeue(out, len);
-        if (n > 0) return n;
-        uint64_t expected = flag_;
+protected:
+    void wait_signal(std::chrono::nanoseconds timeout) override {
         std::unique_lock<std::mutex> lock(mtx_);
-        while (flag_ == expected) { 
-            cv_.wait(lock);
-            lock.unlock();
-            return -1;
+        if (flag_ != 0) {// dequeue 실패 이후 도착한 신호 → 소비하고 wait 건너뜀
+            flag_ = 0;
+            return;
         }
+        waiters_++;
+        count_wait();
+        if (timeout.count() < 0) cv_.wait(lock);
+        else cv_.wait_for(lock, timeout);
+        waiters_--;
+    }
+
+private:
+    // flag 설정 후 wait 중인 컨슈머가 있을 때만 하나 깨움
+    inline void signal_one() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        flag_++;
+        bool need_notify = waiters_ > 0;
         lock.unlock();
-        return -1;
+        if (need_notify) {
+            cv_.notify_one();
+            count_wake();
+        }
     }
 };
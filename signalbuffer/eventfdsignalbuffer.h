@@ -0,0 +1,153 @@
+/*
+ * EventFdSignalBuffer: eventfd 기반 Producer Consumer Queue Wrapper
+ *
+ * 특징:
+ *  - 신호 수단으로 eventfd(EFD_NONBLOCK | EFD_CLOEXEC)를 사용하여 get_fd()로 poll/epoll 가능한 fd 노출
+ *    → OsUtil::get_epoll_fd()/ctl_epoll_fd()로 만든 epoll 루프에 소켓과 함께 등록하여
+ *      한 스레드가 NIC fd와 스레드 간 큐를 polling 없이 동시에 대기할 수 있음
+ *  - armed_ 플래그로 wakeup 병합(coalescing)
+ *      * 컨슈머가 drain()으로 신호를 소비한 뒤 처음 enqueue한 프로듀서만 eventfd에 write
+ *        (empty → non-empty 전이 시점에만 시스템 콜 발생)
+ *      * 컨슈머가 큐를 비우기 전까지 이어지는 enqueue는 atomic exchange 한 번으로 끝남
+ *  - dequeue_wait()/dequeue_wait_for()/dequeue_wait_bulk()는 poll()로 eventfd를 대기
+ *  - WaitStrategy로 park 전 spin(pause) → yield 단계 지정 가능
+ *  - BackpressurePolicy로 링이 가득 찼을 때 동작 지정 (drop-newest / drop-oldest / block / spill)
+ *
+ * 사용 (epoll 루프):
+ *  - OsUtil::ctl_epoll_fd(epoll_fd, EPOLL_CTL_ADD, sig_buf.get_fd(), EPOLLIN);
+ *  - epoll_wait가 해당 fd의 EPOLLIN을 보고하면
+ *      sig_buf.drain();
+ *      while (sig_buf.dequeue(out, len) >= 0) { ... }
+ *    순서로 신호를 먼저 소비한 뒤 큐가 빌 때까지 꺼내야 함 (순서가 바뀌면 lost wakeup 가능)
+ *
+ * 주의:
+ *  - epoll 등록은 level-triggered(EPOLLIN)를 기본으로 가정한다.
+ *  - eventfd 카운터는 모든 대기자가 공유하므로 컨슈머 여러 개가 같은 fd를 대기하면
+ *    한 컨슈머가 drain()한 뒤 나머지는 다음 신호까지 깨어나지 않을 수 있다.
+ *    → 이벤트 루프 스레드 하나가 fd를 소유하는 구성을 권장
+ *  - eventfd 생성 실패 시 get_fd()는 -1을 반환한다.
+ *    이 경우 신호 write는 생략되고, dequeue_wait 계열은 poll 대신 최대 EVENTFD_FALLBACK_SLEEP_US 만큼 sleep 후
+ *    재시도하는 polling으로 동작한다. (무한 대기하지 않음)
+ *
+ * 동작:
+ *  - enqueue_wake(): 데이터 enqueue + armed_가 0 → 1로 바뀐 경우에만 eventfd write
+ *  - wake_all(): armed_ 설정 + eventfd write (poll 중인 모든 컨슈머가 깨어남)
+ *  - drain(): eventfd read로 카운터를 0으로 만들고 armed_ 해제
+ *  - dequeue_wait(): 데이터 있으면 즉시 반환, 없으면 spin → yield → poll 대기 후 drain
+ *
+ * 메모리 오더링:
+ *  - 프로듀서 enqueue(release) → armed_.exchange(1, acq_rel)
+ *  - 컨슈머 drain()의 armed_.exchange(0, acq_rel) 이후 dequeue
+ *    → armed_ == 1을 보고 write를 생략한 프로듀서의 데이터는 drain() 이후 dequeue에서 반드시 보임
+ *    → drain() 이후 enqueue한 프로듀서는 armed_ == 0을 보고 eventfd write
+ *  - armed_ == 1인 동안 eventfd 카운터는 0이 아님(또는 write 직전) → poll이 대기하지 않음
+ */
+
+#pragma once
+#include <atomic>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <thread>
+#include <iostream>
+#include "signalbuffer.h"
+
+#define EVENTFD_FALLBACK_SLEEP_US 1000 // eventfd 생성 실패 시 wait_signal 최대 sleep 시간
+
+class EventFdSignalBuffer : public SignalBuffer{
+    int fd_;
+    alignas(64) std::atomic<int> armed_; // 1: 신호가 write되었고 아직 drain되지 않음
+
+public:
+    EventFdSignalBuffer(std::unique_ptr<SharedBuffer> shared_buf, const WaitStrategy& wait_strategy = WaitStrategy(),
+        const BackpressurePolicy& backpressure = BackpressurePolicy())
+        : SignalBuffer(std::move(shared_buf), wait_strategy, backpressure), fd_(-1), armed_(0)
+    {
+        fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd_ == -1) {
+            std::cerr << "[ERROR] eventfd : " << strerror(errno) << " "
+            << "(EventFdSignalBuffer::EventFdSignalBuffer) " << '\n';
+        }
+    }
+    ~EventFdSignalBuffer() override {
+        if (fd_ != -1) close(fd_);
+    }
+    EventFdSignalBuffer(const EventFdSignalBuffer&) = delete;
+    EventFdSignalBuffer& operator=(const EventFdSignalBuffer&) = delete;
+
+    int32_t enqueue_wake(const uint8_t* data, size_t len) override{
+        int32_t n = enqueue_policy(data, len);
+        signal_one();
+        return n; // -1: full
+    }
+
+    void wake_all() override{
+        armed_.store(1, std::memory_order_release);
+        notify();
+    }
+
+    // epoll/poll 등록용 fd
+    int get_fd() const { return fd_; }
+
+    // eventfd 신호 소비, epoll에서 EPOLLIN을 받은 뒤 dequeue 전에 호출
+    void drain() {
+        uint64_t cnt;
+        if (fd_ != -1) {
+            while (read(fd_, &cnt, sizeof(cnt)) == -1 && errno == EINTR) {}
+        }
+        armed_.exchange(0, std::memory_order_acq_rel);
+    }
+
+protected:
+    void wait_signal(std::chrono::nanoseconds timeout) override{
+        if (fd_ == -1) {// eventfd 없음 → 제한된 시간만 sleep (poll은 음수 fd를 무시하므로 무한 대기가 됨)
+            std::chrono::nanoseconds nap = std::chrono::microseconds(EVENTFD_FALLBACK_SLEEP_US);
+            if (timeout.count() >= 0 && timeout < nap) nap = timeout;
+            count_wait();
+            std::this_thread::sleep_for(nap);
+            return;
+        }
+        struct pollfd pfd;
+        pfd.fd = fd_;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int ms = -1;
+        if (timeout.count() >= 0) {
+            // 1ms 미만 timeout은 올림하여 0(즉시 반환)으로 잘리지 않게 함, int 범위를 넘으면 INT_MAX ms로 제한
+            int64_t ns = timeout.count();
+            int64_t ms64 = ns / 1000000 + (ns % 1000000 != 0 ? 1 : 0);
+            ms = ms64 > INT_MAX ? INT_MAX : static_cast<int>(ms64);
+        }
+        count_wait();
+        int ret = poll(&pfd, 1, ms);
+        if (ret > 0) {
+            drain();
+        } else if (ret == -1 && errno != EINTR) {
+            std::cerr << "[ERROR] poll : " << strerror(errno) << " "
+            << "(EventFdSignalBuffer::wait_signal) " << '\n';
+        }
+    }
+
+private:
+    // empty → non-empty 전이(armed_ 0 → 1)일 때만 eventfd write
+    inline void signal_one() {
+        if (armed_.exchange(1, std::memory_order_acq_rel) == 0)
+            notify();
+    }
+    inline void notify() {
+        if (fd_ == -1) return; // eventfd 생성 실패, 컨슈머는 EVENTFD_FALLBACK_SLEEP_US 주기로 재시도
+        uint64_t one = 1;
+        ssize_t ret;
+        while ((ret = write(fd_, &one, sizeof(one))) == -1 && errno == EINTR) {}
+        if (ret == -1 && errno != EAGAIN) {// EAGAIN: 카운터 포화, 이미 readable 상태
+            std::cerr << "[ERROR] eventfd write : " << strerror(errno) << " "
+            << "(EventFdSignalBuffer::notify) " << '\n';
+            return;
+        }
+        count_wake();
+    }
+};
@@ -12,11 +12,23 @@
  *  - 내부 공유 가능 원형 버퍼 사용, 단일 다중 프로듀서 enqueue 지원
  *  - atomic flag + futex wake/wait 로 lost wakeup 방지
  *  - lock-free 구조로 여러 컨슈머 경쟁 가능
+ *  - WaitStrategy로 park 전 spin(pause) → yield 단계 지정 가능 (적응형 spin-then-park)
+ *  - waiters_ 카운트로 park 중인 컨슈머가 없으면 FUTEX_WAKE 시스템 콜 자체를 생략
+ *  - dequeue_wait_for()/dequeue_wait_bulk()는 FUTEX_WAIT의 상대 timespec으로 대기 시간 제한
+ *  - get_stats()로 enqueue/drop/dequeue/wake/wait/spurious/high-water 통계 조회 (relaxed atomic 카운터)
+ *  - BackpressurePolicy로 링이 가득 찼을 때 동작 지정 (drop-newest / drop-oldest / block / spill)
+ *  - SignalBufferSet에 등록하면 한 컨슈머가 여러 버퍼를 한 번에 대기 가능 (signalbufferset.h 참고)
  *
  * 동작:
- *  - enqueue_wake(): 데이터 enqueue + flag 설정 + futex wake
+ *  - enqueue_wake(): 데이터 enqueue + flag 설정 + (대기자가 있을 때만) futex wake
  *  - wake_all(): 모든 대기 컨슈머 wake
- *  - dequeue_wait(): 데이터 있으면 즉시 반환, 없으면 CAS 후 futex wait
+ *  - dequeue_wait(): 데이터 있으면 즉시 반환, 없으면 spin → yield → waiters_ 증가 후 CAS + futex wait
+ *  - dequeue_wait_for(): dequeue_wait()와 동일하나 timeout 경과 시 깨어나 재시도 후 반환
+ *  - dequeue_wait_bulk(): 한 번 깨어난 뒤 준비된 데이터를 일괄 추출
+ *
+ * 메모리 오더링:
+ *  - 프로듀서 flag store → waiters_ load, 컨슈머 waiters_ 증가 → flag CAS 는 모두 seq_cst
+ *    → 프로듀서가 대기자를 못 보면 컨슈머는 반드시 flag == 1을 보고 wait를 건너뜀 (lost wakeup 없음)
  *
  * 안정성:
  *  - 데이터 폭주, 간헐적 도착 모두 처리 가능
@@ -32,43 +44,79 @@
 #include <unistd.h>
 #include <cstdint>
 #include <climits>
+#include <ctime>
 #include <iostream>
 #include "signalbuffer.h"
 
+// futex_waitv 미지원 커널에서 SignalBufferSet이 공유하는 futex 워드
+struct alignas(64) FutexSetWord {
+    std::atomic<int> seq_;     // 등록된 버퍼 중 하나라도 신호를 보낼 때마다 증가
+    std::atomic<int> waiters_; // seq_에서 futex wait 중(또는 진입 중)인 컨슈머 수
+};
+
+class SignalBufferSet;
+
 class FutexSignalBuffer : public SignalBuffer{
     alignas(4) std::atomic<int> flag_;
+    std::atomic<int> waiters_; // futex wait 중(또는 진입 중)인 컨슈머 수
+    FutexSetWord* set_word_;   // 폴백 모드 SignalBufferSet에 등록된 경우의 공유 워드, 없으면 nullptr
+
+    friend class SignalBufferSet;
 
 public:
-    FutexSignalBuffer(std::unique_ptr<SharedBuffer> shared_buf) : SignalBuffer(std::move(shared_buf)), flag_(0) {}
+    FutexSignalBuffer(std::unique_ptr<SharedBuffer> shared_buf, const WaitStrategy& wait_strategy = WaitStrategy(),
+        const BackpressurePolicy& backpressure = BackpressurePolicy())
+        : SignalBuffer(std::move(shared_buf), wait_strategy, backpressure), flag_(0), waiters_(0), set_word_(nullptr) {}
 
     int32_t enqueue_wake(const uint8_t* data, size_t len) override{
-        int32_t n = shared_buf_->enqueue(data, len);
-        if (n >=0) {
-            atomic_store_explicit(&flag_, 1, std::memory_order_release);
-            syscall(SYS_futex, &flag_, FUTEX_WAKE, 1, nullptr, nullptr, 0);
-        }
-        else{
-            std::cout << "shared_buf_ is pull " << '\n';
-            atomic_store_explicit(&flag_, 1, std::memory_order_release);
-            syscall(SYS_futex, &flag_, FUTEX_WAKE, 1, nullptr, nullptr, 0);
-        }
+        int32_t n = enqueue_policy(data, len);
+        signal_one(); // full이어도 컨슈머를 깨워 소비를 재촉
         return n; // -1: full
     }
 
     void wake_all() override{
         atomic_store_explicit(&flag_, 1, std::memory_order_release);
         syscall(SYS_futex, &flag_, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+        count_wake();
+        if (set_word_) signal_set();
     }
 
-    int32_t dequeue_wait(uint8_t* out, size_t len) override{
-        int32_t n = shared_buf_->dequeue(out, len);
-        if (n >= 0) return n;
+protected:
+    void wait_signal(std::chrono::nanoseconds timeout) override{
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
         int expected = 1;
-        if (!atomic_compare_exchange_strong_explicit(&flag_, &expected, 0, std::memory_order_release, std::memory_order_relaxed)) {
+        if (!atomic_compare_exchange_strong_explicit(&flag_, &expected, 0, std::memory_order_seq_cst, std::memory_order_seq_cst)) {
             // flag가 1이면 0으로 바꾸고 true 반환하고 이것이 반전됨 syscall 건너뜀
             // flag가 0이면 0으로 유지하고 false 반환하고 이것이 반전됨 syscall 들어감 
-            syscall(SYS_futex, &flag_, FUTEX_WAIT, 0, nullptr, nullptr, 0);
+            count_wait();
+            if (timeout.count() < 0) {
+                syscall(SYS_futex, &flag_, FUTEX_WAIT, 0, nullptr, nullptr, 0);
+            } else {
+                struct timespec ts;
+                ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+                ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+                syscall(SYS_futex, &flag_, FUTEX_WAIT, 0, &ts, nullptr, 0);
+            }
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    // flag 설정 후 park 중인 컨슈머가 있을 때만 하나 깨움
+    inline void signal_one() {
+        flag_.store(1, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) > 0) {
+            syscall(SYS_futex, &flag_, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+            count_wake();
+        }
+        if (set_word_) signal_set();
+    }
+    // 공유 워드 seq_ 증가 후 대기 중인 SignalBufferSet이 있을 때만 깨움
+    inline void signal_set() {
+        set_word_->seq_.fetch_add(1, std::memory_order_seq_cst);
+        if (set_word_->waiters_.load(std::memory_order_seq_cst) > 0) {
+            syscall(SYS_futex, &set_word_->seq_, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+            count_wake();
         }
-        return -1;
     }
 };
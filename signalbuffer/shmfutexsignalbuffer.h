@@ -0,0 +1,150 @@
+/*
+ * ShmFutexSignalBuffer: 프로세스 간 공유 Futex 기반 Producer Consumer Queue Wrapper
+ *
+ * 특징:
+ *  - FutexSignalBuffer와 동일한 flag + waiters 알고리즘을 프로세스 간 공유 메모리(ShmRegion) 위에서 수행
+ *  - flag_ / waiters_ 워드가 힙이 아닌 공유 매핑 내부에 존재 → 다른 프로세스의 컨슈머를 직접 wake
+ *  - FUTEX_PRIVATE_FLAG 없는 FUTEX_WAIT / FUTEX_WAKE 사용 → 커널이 (inode, offset) 키로 매칭하므로
+ *    프로세스마다 매핑 주소가 달라도 같은 futex로 인식
+ *  - SPSCShmBuffer / MPMCShmBuffer 등 mmap 기반 링과 짝지어 사용
+ *      → 캡처 프로세스와 분석 프로세스 간 pipe / socket 없이 저지연 blocking handoff
+ *  - WaitStrategy로 park 전 spin(pause) → yield 단계 지정 가능
+ *  - waiters_ 카운트로 park 중인 컨슈머가 없으면 FUTEX_WAKE 시스템 콜 생략
+ *
+ * 사용 방법:
+ *  - 생성 프로세스:
+ *      auto ring = std::make_unique<SPSCShmBuffer>(); ring->create("/cap_ring", 4096);
+ *      ShmFutexSignalBuffer sig(std::move(ring)); sig.create("/cap_sig");
+ *  - 연결 프로세스:
+ *      auto ring = std::make_unique<SPSCShmBuffer>(); ring->attach("/cap_ring");
+ *      ShmFutexSignalBuffer sig(std::move(ring)); sig.attach("/cap_sig");
+ *  - name이 nullptr이면 memfd로 생성되며, get_fd()로 얻은 fd를 fork 또는 SCM_RIGHTS로 전달 후 attach_fd(fd)
+ *
+ * 주의:
+ *  - 전달하는 SharedBuffer는 공유 메모리 링이어야 하며 create()/attach()가 끝난 상태여야 한다.
+ *  - create()/attach() 성공 전에는 enqueue_wake / dequeue_wait 를 호출하지 말 것.
+ *  - BACKPRESSURE_BLOCK은 프로세스 내부 futex로 공간 신호를 주고받으므로 프로세스 간에는 사용할 수 없다.
+ *    (생성자에서 [ERROR] 출력 후 BACKPRESSURE_DROP_NEWEST로 대체)
+ *  - get_stats() 통계는 공유되지 않고 각 프로세스의 객체에서 수행한 동작만 집계한다.
+ *  - 대기 중이던 프로세스가 비정상 종료되면 waiters_가 감소하지 않을 수 있으며,
+ *    이 경우 프로듀서가 불필요한 FUTEX_WAKE를 호출할 뿐 정확성에는 영향이 없다.
+ *
+ * 메모리 오더링:
+ *  - FutexSignalBuffer와 동일: 프로듀서 flag store → waiters_ load, 컨슈머 waiters_ 증가 → flag CAS 는 모두 seq_cst
+ *  - 공유 매핑의 atomic은 lock-free(address-free)여야 하므로 static_assert로 확인
+ */
+
+#pragma once
+#include <atomic>
+#include <new>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <unistd.h>
+#include <cstdint>
+#include <climits>
+#include <ctime>
+#include <iostream>
+#include "signalbuffer.h"
+#include "shmregion.h"
+
+#define SHM_SIGNAL_MAGIC 0x53484d5349473031ULL // "SHMSIG01"
+
+struct alignas(64) ShmSignalHeader {
+    std::atomic<uint64_t> magic_; // 초기화 완료 표시 (마지막에 release store)
+    alignas(64) std::atomic<int> flag_;    // futex 워드
+    std::atomic<int> waiters_;             // futex wait 중(또는 진입 중)인 컨슈머 수 (모든 프로세스 합산)
+};
+static_assert(std::atomic<int>::is_always_lock_free, "shared memory atomics must be address-free");
+static_assert(sizeof(std::atomic<int>) == sizeof(int), "futex word must be 32-bit");
+
+class ShmFutexSignalBuffer : public SignalBuffer{
+private:
+    ShmRegion region_;
+    ShmSignalHeader* hdr_;
+
+public:
+    ShmFutexSignalBuffer(std::unique_ptr<SharedBuffer> shared_buf, const WaitStrategy& wait_strategy = WaitStrategy(),
+        const BackpressurePolicy& backpressure = BackpressurePolicy())
+        : SignalBuffer(std::move(shared_buf), wait_strategy, backpressure), hdr_(nullptr) {
+        // 공간 신호(space_)가 프로세스 로컬 futex → 다른 프로세스의 컨슈머가 깨울 수 없으므로 DROP_NEWEST로 대체
+        if (backpressure_.mode_ == BACKPRESSURE_BLOCK) {
+            std::cerr << "[ERROR] BACKPRESSURE_BLOCK is not supported across processes, fall back to BACKPRESSURE_DROP_NEWEST "
+            << "(ShmFutexSignalBuffer::ShmFutexSignalBuffer) " << '\n';
+            backpressure_.mode_ = BACKPRESSURE_DROP_NEWEST;
+        }
+    }
+
+    // 신호 영역 생성 및 초기화 (name == nullptr 이면 memfd)
+    bool create(const char* name) {
+        if (!region_.create(name, sizeof(ShmSignalHeader))) return false;
+        ShmSignalHeader* hdr = new (region_.get_addr()) ShmSignalHeader();
+        hdr->flag_.store(0, std::memory_order_relaxed);
+        hdr->waiters_.store(0, std::memory_order_relaxed);
+        hdr->magic_.store(SHM_SIGNAL_MAGIC, std::memory_order_release);
+        return bind();
+    }
+    // 다른 프로세스가 생성한 named 신호 영역에 연결
+    bool attach(const char* name) {
+        if (!region_.attach(name)) return false;
+        return bind();
+    }
+    // 전달받은 fd에 연결
+    bool attach_fd(int fd) {
+        if (!region_.attach_fd(fd)) return false;
+        return bind();
+    }
+    int get_fd() const { return region_.get_fd(); }
+
+    int32_t enqueue_wake(const uint8_t* data, size_t len) override{
+        int32_t n = enqueue_policy(data, len);
+        signal_one(); // full이어도 컨슈머를 깨워 소비를 재촉
+        return n; // -1: full
+    }
+
+    void wake_all() override{
+        hdr_->flag_.store(1, std::memory_order_release);
+        syscall(SYS_futex, &hdr_->flag_, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+        count_wake();
+    }
+
+protected:
+    void wait_signal(std::chrono::nanoseconds timeout) override{
+        hdr_->waiters_.fetch_add(1, std::memory_order_seq_cst);
+        int expected = 1;
+        if (!hdr_->flag_.compare_exchange_strong(expected, 0, std::memory_order_seq_cst, std::memory_order_seq_cst)) {
+            count_wait();
+            if (timeout.count() < 0) {
+                syscall(SYS_futex, &hdr_->flag_, FUTEX_WAIT, 0, nullptr, nullptr, 0);
+            } else {
+                struct timespec ts;
+                ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+                ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+                syscall(SYS_futex, &hdr_->flag_, FUTEX_WAIT, 0, &ts, nullptr, 0);
+            }
+        }
+        hdr_->waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    // 매핑된 영역의 헤더 검증
+    bool bind() {
+        ShmSignalHeader* hdr = static_cast<ShmSignalHeader*>(region_.get_addr());
+        if (region_.get_len() < sizeof(ShmSignalHeader)
+            || hdr->magic_.load(std::memory_order_acquire) != SHM_SIGNAL_MAGIC) {
+            std::cerr << "[ERROR] invalid shared memory layout "
+            << "(ShmFutexSignalBuffer::bind) " << '\n';
+            region_.close_region();
+            return false;
+        }
+        hdr_ = hdr;
+        return true;
+    }
+    // flag 설정 후 park 중인 컨슈머(다른 프로세스 포함)가 있을 때만 하나 깨움
+    inline void signal_one() {
+        hdr_->flag_.store(1, std::memory_order_seq_cst);
+        if (hdr_->waiters_.load(std::memory_order_seq_cst) > 0) {
+            syscall(SYS_futex, &hdr_->flag_, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+            count_wake();
+        }
+    }
+};
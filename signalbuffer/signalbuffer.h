@@ -1,18 +1,323 @@
 #pragma once
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <climits>
+#include <ctime>
+#include <iostream>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <unistd.h>
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#endif
 #include "sharedbuffer.h"
 
+// 무한 대기 timeout
+#define WAIT_INFINITE std::chrono::nanoseconds(-1)
+
+// dequeue_wait 대기 전략: spin_cnt_ 회 pause 재시도 → yield_cnt_ 회 yield 재시도 → park(커널 대기)
+// 기본값(0, 0)은 dequeue 실패 즉시 park
+struct WaitStrategy {
+    uint32_t spin_cnt_ = 0;
+    uint32_t yield_cnt_ = 0;
+};
+
+// 링이 가득 찼을 때 enqueue_wake 동작
+enum Backpressure {
+    BACKPRESSURE_DROP_NEWEST, // 새 데이터 버림 후 -1 반환 (기존 동작)
+    BACKPRESSURE_DROP_OLDEST, // 가장 오래된 데이터를 꺼내 버리고 새 데이터 삽입 (RingBuffer::push_infinite와 동일한 의미, 다중 consumer 링 전용)
+    BACKPRESSURE_BLOCK,       // 컨슈머가 공간을 만들 때까지 프로듀서를 futex로 park
+    BACKPRESSURE_SPILL        // set_spill_buffer()로 지정한 overflow 링에 삽입
+};
+
+// 백프레셔 정책, block_timeout_은 BACKPRESSURE_BLOCK에서 최대 대기 시간 (음수면 무한 대기)
+struct BackpressurePolicy {
+    Backpressure mode_ = BACKPRESSURE_DROP_NEWEST;
+    std::chrono::nanoseconds block_timeout_ = WAIT_INFINITE;
+};
+
+// SignalBuffer 통계 스냅샷 (get_stats() 반환값)
+struct SignalStats {
+    uint64_t enqueued_;     // enqueue 성공 개수
+    uint64_t dropped_full_; // 링이 가득 차서 enqueue 실패한 횟수
+    uint64_t evicted_;      // BACKPRESSURE_DROP_OLDEST로 버려진 기존 데이터 개수
+    uint64_t spilled_;      // BACKPRESSURE_SPILL로 overflow 링에 들어간 개수 (enqueued_에 포함)
+    uint64_t blocked_;      // BACKPRESSURE_BLOCK으로 프로듀서가 park한 횟수
+    uint64_t dequeued_;     // dequeue 성공 개수
+    uint64_t wakes_;        // 실제로 수행한 wake(futex wake / notify / eventfd write) 횟수
+    uint64_t waits_;        // 실제로 park(futex wait / cv wait / poll)에 진입한 횟수
+    uint64_t spurious_;     // 깨어났지만 데이터가 없었던 횟수 (타임아웃 제외)
+    uint64_t high_water_;   // 관측된 최대 큐 깊이 (enqueued_ - dequeued_ - evicted_ 기준)
+};
+
+// 통계 카운터, 모두 relaxed atomic
+// 프로듀서 측 / 컨슈머 측 카운터를 서로 다른 캐시 라인에 배치하여 false sharing 방지
+struct SignalCounters {
+    alignas(64) std::atomic<uint64_t> enqueued_{0};
+    std::atomic<uint64_t> dropped_full_{0};
+    std::atomic<uint64_t> evicted_{0};
+    std::atomic<uint64_t> spilled_{0};
+    std::atomic<uint64_t> blocked_{0};
+    std::atomic<uint64_t> wakes_{0};
+    std::atomic<uint64_t> high_water_{0};
+    alignas(64) std::atomic<uint64_t> dequeued_{0};
+    std::atomic<uint64_t> waits_{0};
+    std::atomic<uint64_t> spurious_{0};
+};
+
 class SignalBuffer {
 protected:
-    std::unique_ptr<SharedBuffer> shared_buf_; 
+    std::unique_ptr<SharedBuffer> shared_buf_;
+    WaitStrategy wait_strategy_;
+    BackpressurePolicy backpressure_;
+    std::unique_ptr<SharedBuffer> spill_buf_; // BACKPRESSURE_SPILL용 overflow 링
+    SignalCounters stats_;
+    alignas(64) std::atomic<int> space_;   // BACKPRESSURE_BLOCK: 컨슈머가 공간을 만들었음을 알리는 futex 워드
+    std::atomic<int> space_waiters_;       // BACKPRESSURE_BLOCK: park 중(또는 진입 중)인 프로듀서 수
 
 public:
-    SignalBuffer(std::unique_ptr<SharedBuffer> shared_buf) : shared_buf_(std::move(shared_buf)) {}
+    SignalBuffer(std::unique_ptr<SharedBuffer> shared_buf, const WaitStrategy& wait_strategy = WaitStrategy(),
+                 const BackpressurePolicy& backpressure = BackpressurePolicy())
+        : shared_buf_(std::move(shared_buf)), wait_strategy_(wait_strategy), backpressure_(backpressure),
+          space_(0), space_waiters_(0) {
+        // 프로듀서가 dequeue로 축출하므로 단일 consumer 링에서는 컨슈머와 경쟁 → DROP_NEWEST로 대체
+        if (backpressure_.mode_ == BACKPRESSURE_DROP_OLDEST && !shared_buf_->is_multi_consumer()) {
+            std::cerr << "[ERROR] BACKPRESSURE_DROP_OLDEST requires a multi-consumer ring, fall back to BACKPRESSURE_DROP_NEWEST "
+            << "(SignalBuffer::SignalBuffer) " << '\n';
+            backpressure_.mode_ = BACKPRESSURE_DROP_NEWEST;
+        }
+    }
     virtual ~SignalBuffer() = default;
+    // BACKPRESSURE_SPILL용 overflow 링 지정, 프로듀서 / 컨슈머 시작 전에 호출
+    // overflow 링은 메인 링과 같은 프로듀서 / 컨슈머 구성을 지원해야 함 (미지정 시 DROP_NEWEST로 동작)
+    void set_spill_buffer(std::unique_ptr<SharedBuffer> spill_buf) {
+        spill_buf_ = std::move(spill_buf);
+    }
     // enqueue 시 신호를 보내는 함수
     virtual int32_t enqueue_wake(const uint8_t* data, size_t len) = 0;
     // 대기 중인 컨슈머 모두 깨우기
     virtual void wake_all() = 0;
-    // dequeue 대기
-    virtual int32_t dequeue_wait(uint8_t* out, size_t len) = 0;
+    // 대기 없이 한 번 dequeue 시도, 데이터 없으면 -1 반환
+    int32_t dequeue(uint8_t* out, size_t len) {
+        int32_t n = pop(out, len);
+        if (n >= 0) count_dequeue(1);
+        return n;
+    }
+    // 대기 없이 준비된 데이터를 최대 max개 일괄 추출, 없으면 -1 반환
+    int32_t dequeue_bulk(struct iovec* out_vec, size_t max) {
+        if (max == 0) return 0;
+        int32_t n = pop_bulk(out_vec, max);
+        if (n > 0) count_dequeue(static_cast<uint64_t>(n));
+        return n;
+    }
+    // dequeue 대기, 데이터 있으면 길이 반환, 없으면 신호가 올 때까지 대기 후 한 번 더 시도, 실패 시 -1 반환
+    virtual int32_t dequeue_wait(uint8_t* out, size_t len) {
+        return dequeue_wait_for(out, len, WAIT_INFINITE);
+    }
+    // timeout까지만 dequeue 대기, 깨어난 뒤 한 번 더 시도하여 성공 시 길이 반환, 타임아웃 시 -1 반환
+    int32_t dequeue_wait_for(uint8_t* out, size_t len, std::chrono::nanoseconds timeout) {
+        auto try_once = [&] { return pop(out, len); };
+        int32_t n = spin_retry(try_once);
+        if (n < 0) n = park_retry(timeout, try_once);
+        if (n >= 0) count_dequeue(1);
+        return n;
+    }
+    // 한 번 깨어날 때마다 준비된 데이터를 최대 max개 일괄 추출, 추출 개수 반환, 타임아웃 시 -1 반환
+    // out_vec[i].iov_len은 버퍼 크기 → 추출된 길이로 갱신
+    int32_t dequeue_wait_bulk(struct iovec* out_vec, size_t max, std::chrono::nanoseconds timeout = WAIT_INFINITE) {
+        if (max == 0) return 0;
+        auto try_once = [&] { return pop_bulk(out_vec, max); };
+        int32_t n = spin_retry(try_once);
+        if (n < 0) n = park_retry(timeout, try_once);
+        if (n > 0) count_dequeue(static_cast<uint64_t>(n));
+        return n;
+    }
+
+    // 통계 스냅샷, 각 카운터를 relaxed로 따로 읽으므로 카운터 간 완전한 일관성은 보장하지 않음
+    SignalStats get_stats() const {
+        SignalStats s;
+        s.enqueued_ = stats_.enqueued_.load(std::memory_order_relaxed);
+        s.dropped_full_ = stats_.dropped_full_.load(std::memory_order_relaxed);
+        s.evicted_ = stats_.evicted_.load(std::memory_order_relaxed);
+        s.spilled_ = stats_.spilled_.load(std::memory_order_relaxed);
+        s.blocked_ = stats_.blocked_.load(std::memory_order_relaxed);
+        s.dequeued_ = stats_.dequeued_.load(std::memory_order_relaxed);
+        s.wakes_ = stats_.wakes_.load(std::memory_order_relaxed);
+        s.waits_ = stats_.waits_.load(std::memory_order_relaxed);
+        s.spurious_ = stats_.spurious_.load(std::memory_order_relaxed);
+        s.high_water_ = stats_.high_water_.load(std::memory_order_relaxed);
+        return s;
+    }
+    // 통계 초기화 (프로듀서 / 컨슈머 동작 중 호출 시 high_water_ 등은 근사값이 됨)
+    void reset_stats() {
+        stats_.enqueued_.store(0, std::memory_order_relaxed);
+        stats_.dropped_full_.store(0, std::memory_order_relaxed);
+        stats_.evicted_.store(0, std::memory_order_relaxed);
+        stats_.spilled_.store(0, std::memory_order_relaxed);
+        stats_.blocked_.store(0, std::memory_order_relaxed);
+        stats_.dequeued_.store(0, std::memory_order_relaxed);
+        stats_.wakes_.store(0, std::memory_order_relaxed);
+        stats_.waits_.store(0, std::memory_order_relaxed);
+        stats_.spurious_.store(0, std::memory_order_relaxed);
+        stats_.high_water_.store(0, std::memory_order_relaxed);
+    }
+
+protected:
+    // 신호가 올 때까지 park (timeout < 0 이면 무한 대기), 스피리어스 웨이크업 허용
+    // 실제로 park에 진입한 경우 stats_.waits_ 를 증가시켜야 함
+    virtual void wait_signal(std::chrono::nanoseconds timeout) = 0;
+
+    // backpressure_ 정책에 따라 enqueue (derived 클래스의 enqueue_wake에서 호출), 결과 집계 포함
+    int32_t enqueue_policy(const uint8_t* data, size_t len) {
+        int32_t n = shared_buf_->enqueue(data, len);
+        if (n < 0) {
+            switch (backpressure_.mode_) {
+                case BACKPRESSURE_DROP_OLDEST: n = enqueue_evict(data, len); break;
+                case BACKPRESSURE_BLOCK: n = enqueue_block(data, len); break;
+                case BACKPRESSURE_SPILL:
+                    if (spill_buf_) {
+                        n = spill_buf_->enqueue(data, len);
+                        if (n >= 0) stats_.spilled_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                default: break;
+            }
+        }
+        count_enqueue(n);
+        return n; // -1: full
+    }
+
+    // enqueue 결과 집계, 성공 시 enqueued_ - dequeued_ - evicted_ 로 큐 깊이를 구해 high_water_ 갱신
+    inline void count_enqueue(int32_t n) {
+        if (n < 0) {
+            stats_.dropped_full_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        uint64_t enq = stats_.enqueued_.fetch_add(1, std::memory_order_relaxed) + 1;
+        uint64_t deq = stats_.dequeued_.load(std::memory_order_relaxed)
+                     + stats_.evicted_.load(std::memory_order_relaxed);
+        uint64_t depth = enq > deq ? enq - deq : 0;
+        uint64_t hw = stats_.high_water_.load(std::memory_order_relaxed);
+        while (depth > hw && !stats_.high_water_.compare_exchange_weak(hw, depth, std::memory_order_relaxed)) {}
+    }
+    // dequeue 결과 집계, BACKPRESSURE_BLOCK이면 park 중인 프로듀서에게 공간이 생겼음을 알림
+    inline void count_dequeue(uint64_t cnt) {
+        stats_.dequeued_.fetch_add(cnt, std::memory_order_relaxed);
+        if (backpressure_.mode_ == BACKPRESSURE_BLOCK) signal_space();
+    }
+    inline void count_wake() {
+        stats_.wakes_.fetch_add(1, std::memory_order_relaxed);
+    }
+    inline void count_wait() {
+        stats_.waits_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // park 후 한 번 더 시도, 깨어났는데 데이터가 없으면(타임아웃 경과 제외) spurious_ 집계
+    template <typename F>
+    int32_t park_retry(std::chrono::nanoseconds timeout, F&& try_once) {
+        std::chrono::steady_clock::time_point start;
+        if (timeout.count() >= 0) start = std::chrono::steady_clock::now();
+        wait_signal(timeout);
+        int32_t n = try_once();
+        if (n < 0 && (timeout.count() < 0 || std::chrono::steady_clock::now() - start < timeout))
+            stats_.spurious_.fetch_add(1, std::memory_order_relaxed);
+        return n;
+    }
+
+    // 메인 링 → overflow 링 순서로 dequeue (spill 데이터는 메인 링이 빈 뒤에 소비되므로 순서가 바뀔 수 있음)
+    inline int32_t pop(uint8_t* out, size_t len) {
+        int32_t n = shared_buf_->dequeue(out, len);
+        if (n < 0 && spill_buf_) n = spill_buf_->dequeue(out, len);
+        return n;
+    }
+    inline int32_t pop_bulk(struct iovec* out_vec, size_t max) {
+        int32_t n = shared_buf_->dequeue_bulk(out_vec, max);
+        if (n < 0 && spill_buf_) n = spill_buf_->dequeue_bulk(out_vec, max);
+        return n;
+    }
+
+    // 가장 오래된 데이터를 꺼내 버리며 공간 확보 후 재시도
+    // 프로듀서가 dequeue를 수행하므로 메인 링은 다중 consumer를 지원해야 함 (SPMC / MPMC, 생성자에서 확인)
+    // 꺼낼 데이터가 없는데도 enqueue가 실패하면(길이 초과 등 full 이외의 실패) -1 반환
+    int32_t enqueue_evict(const uint8_t* data, size_t len) {
+        int32_t n;
+        uint8_t discard;
+        do {
+            bool evicted = shared_buf_->dequeue(&discard, 0) >= 0;
+            if (evicted)
+                stats_.evicted_.fetch_add(1, std::memory_order_relaxed);
+            n = shared_buf_->enqueue(data, len);
+            if (n < 0 && !evicted)
+                return -1; // 진행 없음
+        } while (n < 0);
+        return n;
+    }
+
+    // 컨슈머가 공간을 만들 때까지 space_ futex로 park 후 재시도, block_timeout_ 경과 시 -1 반환
+    int32_t enqueue_block(const uint8_t* data, size_t len) {
+        std::chrono::nanoseconds timeout = backpressure_.block_timeout_;
+        std::chrono::steady_clock::time_point deadline;
+        if (timeout.count() >= 0) deadline = std::chrono::steady_clock::now() + timeout;
+        stats_.blocked_.fetch_add(1, std::memory_order_relaxed);
+        space_waiters_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int32_t n;
+        while ((n = shared_buf_->enqueue(data, len)) < 0) {
+            int expected = 1;
+            if (space_.compare_exchange_strong(expected, 0, std::memory_order_seq_cst, std::memory_order_seq_cst))
+                continue; // park 전에 공간 신호 도착
+            if (timeout.count() < 0) {
+                syscall(SYS_futex, &space_, FUTEX_WAIT_PRIVATE, 0, nullptr, nullptr, 0);
+            } else {
+                auto remain = deadline - std::chrono::steady_clock::now();
+                if (remain <= std::chrono::nanoseconds::zero()) break;
+                int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remain).count();
+                struct timespec ts;
+                ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+                ts.tv_nsec = static_cast<long>(ns % 1000000000);
+                syscall(SYS_futex, &space_, FUTEX_WAIT_PRIVATE, 0, &ts, nullptr, 0);
+            }
+        }
+        space_waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return n;
+    }
+    // dequeue로 슬롯이 비워진 뒤 park 중인 프로듀서가 있을 때만 wake
+    inline void signal_space() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (space_waiters_.load(std::memory_order_relaxed) > 0) {
+            space_.store(1, std::memory_order_seq_cst);
+            syscall(SYS_futex, &space_, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+        }
+    }
+
+    // park 전 spin → yield 단계 동안 try_once 재시도, 성공 시 결과 반환, 실패 시 -1 반환
+    template <typename F>
+    int32_t spin_retry(F&& try_once) {
+        int32_t n = try_once();
+        for (uint32_t i = 0; n < 0 && i < wait_strategy_.spin_cnt_; ++i) {
+            backoff();
+            n = try_once();
+        }
+        for (uint32_t i = 0; n < 0 && i < wait_strategy_.yield_cnt_; ++i) {
+            std::this_thread::yield();
+            n = try_once();
+        }
+        return n;
+    }
+    // CPU별 pause/yield 백오프
+    static inline void backoff() {
+    #if defined(_MSC_VER)
+        _mm_pause();
+    #elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+    #elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+    #elif defined(__riscv)
+        __asm__ __volatile__("pause");
+    #endif
+    }
 };
\ No newline at end of file
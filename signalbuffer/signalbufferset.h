@@ -0,0 +1,186 @@
+/*
+ * SignalBufferSet: 여러 FutexSignalBuffer를 한 번에 대기하는 컨슈머용 집합
+ *
+ * 특징:
+ *  - NIC 큐별/우선순위별로 나뉜 FutexSignalBuffer 여러 개를 한 스레드가 동시에 park
+ *  - Linux 5.16+ 에서는 futex_waitv 한 번의 시스템 콜로 각 버퍼의 flag_ 워드를 모두 대기
+ *      * 프로듀서 쪽 코드 변경 없음 → 기존 signal_one()의 FUTEX_WAKE가 그대로 집합을 깨움
+ *  - futex_waitv 미지원 커널(ENOSYS) 또는 헤더에서는 공유 futex 워드(FutexSetWord)로 폴백
+ *      * 등록된 버퍼는 신호 시 공유 워드 seq_를 증가시키고, 대기자가 있을 때만 FUTEX_WAKE
+ *  - 지원 여부는 생성 시 한 번만 검사 (futex_waitv에 0개를 넘겨 EINVAL/ENOSYS로 판별)
+ *  - 깨어난 뒤 신호가 온 버퍼 번호를 ready 배열로 반환 → round-robin polling 없이 해당 버퍼만 처리
+ *
+ * 사용:
+ *  - SignalBufferSet set;
+ *    set.add(&buf0); set.add(&buf1);
+ *    while (run) {
+ *        int32_t n = set.wait(ready, max);
+ *        for (int32_t i = 0; i < n; ++i)
+ *            while (set.get(ready[i])->dequeue(out, len) >= 0) { ... }
+ *    }
+ *
+ * 주의:
+ *  - 등록된 버퍼의 컨슈머는 이 집합 하나여야 한다. (버퍼의 dequeue_wait()와 혼용 금지)
+ *  - wait()가 보고한 버퍼는 dequeue()가 -1을 반환할 때까지 비워야 한다.
+ *    신호(flag_)는 보고 시점에 소비되므로 남은 데이터에 대해서는 다시 깨어나지 않는다.
+ *  - add()는 프로듀서 / 컨슈머 스레드 시작 전에 호출해야 하며, 최대 SIGNAL_SET_MAX개까지 등록 가능
+ *  - 집합은 등록된 버퍼보다 먼저 파괴되어야 하며, 파괴 시 버퍼와의 연결을 해제한다.
+ *
+ * 동작:
+ *  - wait(): 이미 신호가 온 버퍼가 있으면 즉시 반환
+ *            없으면 모든 버퍼의 waiters_ 증가 → flag_ 재확인 → futex_waitv(flag_ == 0) 대기
+ *            (폴백: 공유 워드 seq_ 스냅샷 → waiters_ 증가 → flag_ 재확인 → FUTEX_WAIT(seq_))
+ *            깨어나면 flag_를 1 → 0으로 CAS한 버퍼 번호를 ready에 기록
+ *
+ * 메모리 오더링:
+ *  - 집합의 waiters_ 증가 → flag_ load, 프로듀서 flag_ store → waiters_ load 는 모두 seq_cst
+ *    → FutexSignalBuffer 단일 대기와 같은 Dekker 짝으로 lost wakeup 없음
+ *  - 폴백 모드에서 프로듀서는 flag_ store → seq_ 증가 순서, 집합은 seq_ 스냅샷 → flag_ load 순서
+ *    → flag_를 못 본 집합은 반드시 이전 seq_로 FUTEX_WAIT하여 즉시 반환(EAGAIN)되거나 wake를 받음
+ */
+
+#pragma once
+#include <atomic>
+#include <vector>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include "futexsignalbuffer.h"
+
+#if defined(SYS_futex_waitv) && defined(FUTEX_WAITV_MAX)
+#define SIGNAL_SET_HAS_WAITV 1
+#define SIGNAL_SET_MAX FUTEX_WAITV_MAX
+#else
+#define SIGNAL_SET_HAS_WAITV 0
+#define SIGNAL_SET_MAX 128
+#endif
+
+class SignalBufferSet {
+private:
+    std::vector<FutexSignalBuffer*> bufs_;
+#if SIGNAL_SET_HAS_WAITV
+    std::vector<struct futex_waitv> waitv_;
+#endif
+    bool use_waitv_;
+    FutexSetWord word_;
+
+public:
+    SignalBufferSet() : use_waitv_(false)
+    {
+        word_.seq_.store(0, std::memory_order_relaxed);
+        word_.waiters_.store(0, std::memory_order_relaxed);
+#if SIGNAL_SET_HAS_WAITV
+        // 0개 대기는 지원 커널에서 EINVAL, 미지원 커널에서 ENOSYS
+        if (syscall(SYS_futex_waitv, nullptr, 0, 0, nullptr, CLOCK_MONOTONIC) == -1 && errno != ENOSYS)
+            use_waitv_ = true;
+#endif
+    }
+    ~SignalBufferSet() {
+        for (FutexSignalBuffer* buf : bufs_)
+            buf->set_word_ = nullptr;
+    }
+    SignalBufferSet(const SignalBufferSet&) = delete;
+    SignalBufferSet& operator=(const SignalBufferSet&) = delete;
+
+    // 버퍼 등록, 성공 시 버퍼 번호 반환, 가득 차면 -1 반환
+    int32_t add(FutexSignalBuffer* buf) {
+        if (bufs_.size() >= SIGNAL_SET_MAX) {
+            std::cerr << "[ERROR] signal buffer set is full : " << SIGNAL_SET_MAX << " "
+            << "(SignalBufferSet::add) " << '\n';
+            return -1;
+        }
+#if SIGNAL_SET_HAS_WAITV
+        if (use_waitv_) {
+            struct futex_waitv w;
+            std::memset(&w, 0, sizeof(w));
+            w.val = 0;
+            w.uaddr = reinterpret_cast<uintptr_t>(&buf->flag_);
+            w.flags = FUTEX_32; // FutexSignalBuffer의 FUTEX_WAIT/WAKE와 같은 shared 키
+            waitv_.push_back(w);
+        }
+#endif
+        if (!use_waitv_) buf->set_word_ = &word_;
+        bufs_.push_back(buf);
+        return static_cast<int32_t>(bufs_.size() - 1);
+    }
+
+    // 신호가 온 버퍼 번호를 최대 max개 ready에 기록하고 개수 반환
+    // 없으면 신호가 올 때까지 대기 (timeout < 0 이면 무한 대기), 타임아웃/스피리어스 웨이크업 시 -1 반환
+    int32_t wait(size_t* ready, size_t max, std::chrono::nanoseconds timeout = WAIT_INFINITE) {
+        int32_t n = collect(ready, max);
+        if (n > 0) return n;
+        if (use_waitv_) park_waitv(timeout);
+        else park_shared(timeout);
+        n = collect(ready, max);
+        return n > 0 ? n : -1;
+    }
+
+    FutexSignalBuffer* get(size_t idx) const { return bufs_[idx]; }
+    size_t get_cnt() const { return bufs_.size(); }
+    bool is_waitv() const { return use_waitv_; }
+
+private:
+    // flag_ == 1인 버퍼의 신호를 소비하고 번호 기록 (max 초과분은 다음 wait()에서 보고)
+    int32_t collect(size_t* ready, size_t max) {
+        size_t cnt = 0;
+        for (size_t i = 0; i < bufs_.size() && cnt < max; ++i) {
+            std::atomic<int>& flag = bufs_[i]->flag_;
+            if (flag.load(std::memory_order_relaxed) == 0) continue;
+            int expected = 1;
+            if (flag.compare_exchange_strong(expected, 0, std::memory_order_acquire, std::memory_order_relaxed))
+                ready[cnt++] = i;
+        }
+        return static_cast<int32_t>(cnt);
+    }
+    bool any_signaled() const {
+        for (FutexSignalBuffer* buf : bufs_)
+            if (buf->flag_.load(std::memory_order_seq_cst) != 0) return true;
+        return false;
+    }
+
+    void park_waitv(std::chrono::nanoseconds timeout) {
+#if SIGNAL_SET_HAS_WAITV
+        for (FutexSignalBuffer* buf : bufs_)
+            buf->waiters_.fetch_add(1, std::memory_order_seq_cst);
+        if (!any_signaled()) {
+            if (timeout.count() < 0) {
+                syscall(SYS_futex_waitv, waitv_.data(), waitv_.size(), 0, nullptr, CLOCK_MONOTONIC);
+            } else {
+                // futex_waitv는 절대 시각 timeout만 지원
+                struct timespec ts;
+                clock_gettime(CLOCK_MONOTONIC, &ts);
+                int64_t ns = static_cast<int64_t>(ts.tv_nsec) + timeout.count();
+                ts.tv_sec += static_cast<time_t>(ns / 1000000000);
+                ts.tv_nsec = static_cast<long>(ns % 1000000000);
+                syscall(SYS_futex_waitv, waitv_.data(), waitv_.size(), 0, &ts, CLOCK_MONOTONIC);
+            }
+        }
+        for (FutexSignalBuffer* buf : bufs_)
+            buf->waiters_.fetch_sub(1, std::memory_order_relaxed);
+#else
+        park_shared(timeout);
+#endif
+    }
+
+    void park_shared(std::chrono::nanoseconds timeout) {
+        int seq = word_.seq_.load(std::memory_order_seq_cst);
+        word_.waiters_.fetch_add(1, std::memory_order_seq_cst);
+        if (!any_signaled()) {
+            if (timeout.count() < 0) {
+                syscall(SYS_futex, &word_.seq_, FUTEX_WAIT, seq, nullptr, nullptr, 0);
+            } else {
+                struct timespec ts;
+                ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+                ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+                syscall(SYS_futex, &word_.seq_, FUTEX_WAIT, seq, &ts, nullptr, 0);
+            }
+        }
+        word_.waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,100 @@
+/*
+ * SignalStatsExporter: SignalBuffer 통계 주기 출력 스레드
+ *
+ * 특징:
+ *  - add(name, buf)로 등록한 SignalBuffer의 get_stats() 스냅샷을 interval마다 수집
+ *  - 수집 결과는 콜백(name, stats)으로 전달, 콜백 미지정 시 한 줄 요약을 std::cout에 출력
+ *      → 출력 I/O는 이 스레드에서만 발생하므로 프로듀서 / 컨슈머 hot path를 막지 않음
+ *  - STDThread 기반: start_thread()로 시작, stop_thread() 또는 소멸 시 종료
+ *  - 종료 요청에 빠르게 반응하도록 interval을 최대 EXPORT_TICK_MS 단위로 나누어 sleep
+ *
+ * 주의:
+ *  - 등록된 SignalBuffer는 exporter보다 오래 살아 있거나, 파괴 전에 remove()로 해제해야 한다.
+ *  - 콜백은 exporter 스레드에서 호출되므로 스레드 안전해야 한다.
+ */
+
+#pragma once
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <iostream>
+#include "stdthread.h"
+#include "signalbuffer.h"
+
+#define EXPORT_TICK_MS 10
+
+using SignalStatsCallback = std::function<void(const std::string& name, const SignalStats& stats)>;
+
+class SignalStatsExporter : public STDThread {
+private:
+    std::chrono::milliseconds interval_;
+    SignalStatsCallback callback_;
+    std::mutex mtx_; // bufs_ 보호
+    std::vector<std::pair<std::string, const SignalBuffer*>> bufs_;
+
+public:
+    SignalStatsExporter(std::chrono::milliseconds interval, SignalStatsCallback callback = nullptr)
+        : interval_(interval), callback_(std::move(callback)) {}
+    ~SignalStatsExporter() override { stop_thread(); }
+
+    // 통계 수집 대상 등록 (실행 중에도 호출 가능)
+    void add(const std::string& name, const SignalBuffer* buf) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        bufs_.emplace_back(name, buf);
+    }
+    // 통계 수집 대상 해제, SignalBuffer 파괴 전 호출
+    void remove(const SignalBuffer* buf) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (auto it = bufs_.begin(); it != bufs_.end();) {
+            if (it->second == buf) it = bufs_.erase(it);
+            else ++it;
+        }
+    }
+    // 등록된 모든 버퍼의 스냅샷을 즉시 한 번 내보냄
+    void export_once() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (const auto& entry : bufs_) {
+            SignalStats stats = entry.second->get_stats();
+            if (callback_) callback_(entry.first, stats);
+            else print(entry.first, stats);
+        }
+    }
+
+    // 기본 출력 형식
+    static void print(const std::string& name, const SignalStats& s) {
+        uint64_t out = s.dequeued_ + s.evicted_;
+        uint64_t depth = s.enqueued_ > out ? s.enqueued_ - out : 0;
+        std::cout << "[STATS] " << name
+        << " enqueued=" << s.enqueued_
+        << " dropped_full=" << s.dropped_full_
+        << " evicted=" << s.evicted_
+        << " spilled=" << s.spilled_
+        << " blocked=" << s.blocked_
+        << " dequeued=" << s.dequeued_
+        << " depth=" << depth
+        << " high_water=" << s.high_water_
+        << " wakes=" << s.wakes_
+        << " waits=" << s.waits_
+        << " spurious=" << s.spurious_ << '\n';
+    }
+
+private:
+    bool setup() override { return true; }
+    void cleanup() override {}
+    void thread_loop() override {
+        while (!thread_term_.load(std::memory_order_acquire)) {
+            auto deadline = std::chrono::steady_clock::now() + interval_;
+            while (!thread_term_.load(std::memory_order_acquire)) {
+                auto now = std::chrono::steady_clock::now();
+                if (now >= deadline) break;
+                std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+                    deadline - now, std::chrono::milliseconds(EXPORT_TICK_MS)));
+            }
+            if (thread_term_.load(std::memory_order_acquire)) break;
+            export_once();
+        }
+    }
+};
@@ -0,0 +1,127 @@
+/*
+ * DistRWLock: Distributed (Big-Reader) Reader-Writer Spin Lock
+ *
+ * 특징:
+ *  - 리더 카운터를 DIST_RW_SLOTS개의 슬롯으로 분산, 슬롯마다 64바이트 캐시 라인 하나를 차지
+ *      * 각 스레드는 처음 사용할 때 라운드로빈으로 슬롯 하나를 배정받아 계속 사용 (thread_local)
+ *      * 리더는 자기 슬롯 카운터만 증가/감소 → RWSpinLock처럼 모든 코어가 state_ 한 줄을 두드리지 않음
+ *      * 경합 없는 읽기 비용: 로컬 캐시 라인 fetch_add 1회 + writer_ load 1회
+ *  - writer는 writer_ 플래그를 세운 뒤 모든 슬롯을 순회하며 리더가 빠질 때까지 대기
+ *      → 쓰기 비용은 슬롯 수에 비례 (읽기가 압도적으로 많은 라우팅/ARP/flow 테이블 용도)
+ *  - writer_가 서 있으면 새 리더는 카운터를 되돌리고 대기 → writer starvation 없음 (writer 우선)
+ *  - RWSpinLock과 동일한 lock_shared()/unlock_shared()/lock()/unlock() API (std::shared_lock 등과 호환)
+ *  - 순수 스핀락 기반, 커널 블록킹 없음
+ *
+ * 메모리 오더링:
+ *  - 리더: 슬롯 fetch_add(seq_cst) → writer_ load(seq_cst), writer: writer_ CAS(seq_cst) → 슬롯 load(seq_cst)
+ *      * Dekker 패턴: 리더와 writer 중 적어도 한쪽은 상대의 store를 반드시 관찰
+ *  - unlock_shared(): 슬롯 fetch_sub(release), unlock(): writer_ store(release)
+ *
+ * 주의:
+ *  - 락 하나가 DIST_RW_SLOTS * 64 바이트를 차지한다. (기본 4KB)
+ *  - 스레드 수가 DIST_RW_SLOTS보다 많으면 일부 스레드가 슬롯을 공유한다. (정확성에는 영향 없음)
+ *  - lock_shared()를 호출한 스레드가 unlock_shared()를 호출해야 한다. (슬롯이 스레드 로컬)
+ *  - 쓰기가 잦은 경우 슬롯 순회 비용 때문에 RWSpinLock보다 느리다.
+ *
+ * 사용 예시:
+ *  DistRWLock lock;
+ *  lock.lock_shared();   // lookup
+ *  lock.unlock_shared();
+ *  lock.lock();          // update
+ *  lock.unlock();
+ */
+
+#pragma once
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#endif
+
+#define DIST_RW_SLOTS 64        // 리더 카운터 슬롯 수
+#define DIST_RW_SPIN_YIELD 1024 // 이 횟수만큼 pause 스핀 후 yield
+
+struct alignas(64) DistRWSlot {
+    std::atomic<uint32_t> readers_; // 이 슬롯을 사용하는 스레드 중 읽기 락 보유 수
+};
+
+class alignas(64) DistRWLock {
+private:
+    alignas(64) std::atomic<bool> writer_; // writer 보유 또는 획득 중
+    DistRWSlot slots_[DIST_RW_SLOTS];
+
+public:
+    DistRWLock() : writer_(false) {
+        for (uint32_t i = 0; i < DIST_RW_SLOTS; ++i) slots_[i].readers_.store(0, std::memory_order_relaxed);
+    }
+    DistRWLock(const DistRWLock&) = delete;
+    DistRWLock& operator=(const DistRWLock&) = delete;
+
+    // Acquire shared (reader) lock
+    inline void lock_shared() {
+        DistRWSlot& slot = slots_[slot_idx()];
+        uint32_t spin = 0;
+        while (true) {
+            slot.readers_.fetch_add(1, std::memory_order_seq_cst);
+            if (!writer_.load(std::memory_order_seq_cst)) return;
+            // writer active or pending: undo and wait
+            slot.readers_.fetch_sub(1, std::memory_order_release);
+            while (writer_.load(std::memory_order_relaxed)) {
+                backoff(spin);
+            }
+        }
+    }
+
+    // Release shared (reader) lock
+    inline void unlock_shared() {
+        slots_[slot_idx()].readers_.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Acquire exclusive (writer) lock
+    inline void lock() {
+        uint32_t spin = 0;
+        bool expected = false;
+        while (!writer_.compare_exchange_weak(expected, true, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            expected = false;
+            backoff(spin);
+        }
+        // sweep all slots until readers have exited
+        for (uint32_t i = 0; i < DIST_RW_SLOTS; ++i) {
+            while (slots_[i].readers_.load(std::memory_order_seq_cst) != 0) {
+                backoff(spin);
+            }
+        }
+    }
+
+    // Release exclusive (writer) lock
+    inline void unlock() {
+        writer_.store(false, std::memory_order_release);
+    }
+
+private:
+    // 스레드별 슬롯 번호 (최초 호출 시 라운드로빈 배정)
+    static inline uint32_t slot_idx() {
+        static std::atomic<uint32_t> next_slot(0);
+        static thread_local uint32_t idx = next_slot.fetch_add(1, std::memory_order_relaxed) % DIST_RW_SLOTS;
+        return idx;
+    }
+
+    // CPU별 pause 백오프, DIST_RW_SPIN_YIELD 회 초과 시 yield
+    static inline void backoff(uint32_t& spin) {
+        if (++spin >= DIST_RW_SPIN_YIELD) {
+            spin = 0;
+            std::this_thread::yield();
+            return;
+        }
+    #if defined(_MSC_VER)
+        _mm_pause();
+    #elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+    #elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+    #elif defined(__riscv)
+        __asm__ __volatile__("pause");
+    #endif
+    }
+};
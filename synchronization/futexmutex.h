@@ -0,0 +1,281 @@
+/*
+ * FutexMutex / FutexRWMutex: Hybrid Spin-then-Sleep Mutex (Linux futex)
+ *
+ * 특징:
+ *  - FutexMutex: 3상태 워드(state_) 기반 mutex
+ *      * FUTEX_UNLOCKED(0) / FUTEX_LOCKED(1, 대기자 없음) / FUTEX_CONTENDED(2, 대기자 있을 수 있음)
+ *      * 경합 없는 lock(): CAS 1회, unlock(): exchange 1회 (시스템 콜 없음)
+ *      * unlock() 시 이전 상태가 FUTEX_CONTENDED일 때만 FUTEX_WAKE 호출
+ *  - FutexRWMutex: RWSpinLock(RW_WRITER_PREFER)과 같은 상태 워드 + 대기용 시퀀스 futex
+ *      * 경합 없는 lock_shared()/unlock_shared(): CAS 1회 / fetch_sub 1회
+ *      * 대기 중인 writer는 WRITER_PENDING_BIT로 새 리더 진입 차단 (writer starvation 방지)
+ *      * 잠든 스레드가 있을 때만 wake_seq_ 증가 + FUTEX_WAKE (waiters_ 카운트로 불필요한 시스템 콜 생략)
+ *  - 적응형 스핀(AdaptiveSpin): 잠들기 전 최대 limit()번 pause 스핀
+ *      * 최근 스핀으로 획득에 성공했을 때 걸린 스핀 횟수(≈ 보유 시간)의 이동 평균으로 한계를 조정
+ *      * 한계까지 스핀하고도 획득하지 못하면 평균을 절반으로 줄임 (긴 보유가 이어지면 한계가 FUTEX_SPIN_MIN 쪽으로 수렴)
+ *      * 보유 시간이 짧으면 스핀으로 획득, 길거나 보유자가 선점되면 빠르게 futex로 잠듦
+ *      → 과구독(스레드 수 > 코어 수) 환경에서 보유자가 선점되어도 대기자가 코어를 태우지 않음
+ *  - SpinLock / RWSpinLock과 동일한 API (std::lock_guard / std::shared_lock 등과 호환)
+ *  - 64바이트 캐시 라인 정렬로 false sharing 최소화
+ *
+ * 메모리 오더링:
+ *  - lock()/lock_shared(): state_ CAS / exchange acquire
+ *  - unlock()/unlock_shared(): state_ exchange / fetch_sub release
+ *  - FutexRWMutex 대기: waiters_ 증가 → wake_seq_ load → state_ 재확인 (seq_cst)
+ *    해제: state_ 갱신 → waiters_ load (seq_cst), Dekker 패턴으로 lost wake-up 방지
+ *
+ * 주의:
+ *  - FUTEX_PRIVATE_FLAG를 사용하므로 프로세스 간 공유 메모리에 두고 사용할 수 없다.
+ *  - 재귀 획득 불가, lock()한 스레드가 unlock()해야 한다.
+ *  - FutexRWMutex 해제 시 잠든 스레드를 모두 깨우므로 대기자가 매우 많으면 thundering herd 발생 가능
+ *
+ * 사용 예시:
+ *  FutexMutex mtx;
+ *  std::lock_guard<FutexMutex> guard(mtx);
+ *
+ *  FutexRWMutex rw;
+ *  rw.lock_shared();  // lookup
+ *  rw.unlock_shared();
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <climits>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <unistd.h>
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#endif
+
+#define FUTEX_UNLOCKED 0
+#define FUTEX_LOCKED 1
+#define FUTEX_CONTENDED 2
+
+#define FUTEX_SPIN_MIN 16     // 적응형 스핀 하한
+#define FUTEX_SPIN_MAX 4096   // 적응형 스핀 상한
+#define FUTEX_SPIN_INIT 128   // 초기 스핀 한계
+
+#define FUTEX_RW_WRITER_BIT (1u << 31)
+#define FUTEX_RW_PENDING_BIT (1u << 30)
+#define FUTEX_RW_READER_MASK (FUTEX_RW_PENDING_BIT - 1)
+
+// 최근 스핀 획득 비용의 이동 평균으로 다음 스핀 한계를 정함
+struct AdaptiveSpin {
+    std::atomic<uint32_t> avg_;
+
+    AdaptiveSpin() : avg_(FUTEX_SPIN_INIT / 2) {}
+    // 잠들기 전 허용 스핀 횟수
+    inline uint32_t limit() const {
+        uint32_t lim = avg_.load(std::memory_order_relaxed) * 2 + FUTEX_SPIN_MIN;
+        return lim > FUTEX_SPIN_MAX ? FUTEX_SPIN_MAX : lim;
+    }
+    // spun: 스핀으로 획득하기까지(또는 스핀을 중단하기까지) 실제로 스핀한 횟수
+    inline void update(uint32_t spun) {
+        int32_t avg = static_cast<int32_t>(avg_.load(std::memory_order_relaxed));
+        avg += (static_cast<int32_t>(spun) - avg) / 8;
+        avg_.store(static_cast<uint32_t>(avg), std::memory_order_relaxed);
+    }
+    // 한계까지 스핀하고도 획득하지 못함 → 다음 대기자는 더 빨리 잠들도록 평균 감소
+    inline void miss() {
+        avg_.store(avg_.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+    }
+    static inline void pause() {
+    #if defined(_MSC_VER)
+        _mm_pause();
+    #elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+    #elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+    #elif defined(__riscv)
+        __asm__ __volatile__("pause");
+    #endif
+    }
+};
+
+class alignas(64) FutexMutex {
+private:
+    std::atomic<int> state_; // FUTEX_UNLOCKED / FUTEX_LOCKED / FUTEX_CONTENDED
+    AdaptiveSpin spin_;
+
+public:
+    FutexMutex() : state_(FUTEX_UNLOCKED) {}
+    FutexMutex(const FutexMutex&) = delete;
+    FutexMutex& operator=(const FutexMutex&) = delete;
+
+    // 락 획득 (스핀 후 block)
+    inline void lock() {
+        int c = FUTEX_UNLOCKED;
+        if (state_.compare_exchange_strong(c, FUTEX_LOCKED, std::memory_order_acquire, std::memory_order_relaxed)) return;
+        lock_slow();
+    }
+
+    // 락 해제
+    inline void unlock() {
+        if (state_.exchange(FUTEX_UNLOCKED, std::memory_order_release) == FUTEX_CONTENDED) {
+            syscall(SYS_futex, &state_, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        }
+    }
+
+    // 비차단 try-lock (즉시 시도 후 실패 시 false)
+    inline bool try_lock() {
+        int c = FUTEX_UNLOCKED;
+        return state_.compare_exchange_strong(c, FUTEX_LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+private:
+    void lock_slow() {
+        uint32_t limit = spin_.limit();
+        uint32_t i = 0;
+        while (i < limit) {
+            AdaptiveSpin::pause();
+            ++i;
+            int c = state_.load(std::memory_order_relaxed);
+            if (c == FUTEX_UNLOCKED
+                && state_.compare_exchange_strong(c, FUTEX_LOCKED, std::memory_order_acquire, std::memory_order_relaxed)) {
+                spin_.update(i);
+                return;
+            }
+            if (c == FUTEX_CONTENDED) break; // 이미 잠든 대기자가 있음 → 스핀해도 순서상 불리
+        }
+        if (i < limit) spin_.update(i); // 조기 중단: 실제 스핀 횟수 기록
+        else spin_.miss();
+        // 대기자 있음으로 표시하고 잠듦, 깨어나면 다시 CONTENDED로 획득 시도
+        int c = state_.exchange(FUTEX_CONTENDED, std::memory_order_acquire);
+        while (c != FUTEX_UNLOCKED) {
+            syscall(SYS_futex, &state_, FUTEX_WAIT_PRIVATE, FUTEX_CONTENDED, nullptr, nullptr, 0);
+            c = state_.exchange(FUTEX_CONTENDED, std::memory_order_acquire);
+        }
+    }
+};
+
+class alignas(64) FutexRWMutex {
+private:
+    std::atomic<uint32_t> state_;    // WRITER_BIT | PENDING_BIT | reader count
+    std::atomic<uint32_t> wake_seq_; // futex 워드: 해제될 때마다 증가
+    std::atomic<int> waiters_;       // futex wait 중(또는 진입 중)인 스레드 수
+    AdaptiveSpin spin_;
+
+public:
+    FutexRWMutex() : state_(0), wake_seq_(0), waiters_(0) {}
+    FutexRWMutex(const FutexRWMutex&) = delete;
+    FutexRWMutex& operator=(const FutexRWMutex&) = delete;
+
+    // Acquire shared (reader) lock
+    inline void lock_shared() {
+        uint32_t old = state_.load(std::memory_order_relaxed);
+        if (!(old & (FUTEX_RW_WRITER_BIT | FUTEX_RW_PENDING_BIT))
+            && state_.compare_exchange_weak(old, old + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return;
+        }
+        lock_shared_slow();
+    }
+
+    // Release shared (reader) lock
+    inline void unlock_shared() {
+        uint32_t prev = state_.fetch_sub(1, std::memory_order_seq_cst);
+        // last reader leaving while a writer waits
+        if ((prev & FUTEX_RW_READER_MASK) == 1 && (prev & FUTEX_RW_PENDING_BIT)) wake_waiters();
+    }
+
+    // Acquire exclusive (writer) lock
+    inline void lock() {
+        uint32_t old = 0;
+        if (state_.compare_exchange_strong(old, FUTEX_RW_WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed)) return;
+        lock_slow();
+    }
+
+    // Release exclusive (writer) lock
+    inline void unlock() {
+        // keep pending bit set by other waiting writers
+        state_.fetch_and(~FUTEX_RW_WRITER_BIT, std::memory_order_seq_cst);
+        wake_waiters();
+    }
+
+    // 비차단 try-lock
+    inline bool try_lock() {
+        uint32_t old = state_.load(std::memory_order_relaxed);
+        if (old & (FUTEX_RW_WRITER_BIT | FUTEX_RW_READER_MASK)) return false;
+        return state_.compare_exchange_strong(old, FUTEX_RW_WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+    inline bool try_lock_shared() {
+        uint32_t old = state_.load(std::memory_order_relaxed);
+        if (old & (FUTEX_RW_WRITER_BIT | FUTEX_RW_PENDING_BIT)) return false;
+        return state_.compare_exchange_strong(old, old + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+private:
+    void lock_shared_slow() {
+        uint32_t limit = spin_.limit();
+        uint32_t spun = 0;
+        while (true) {
+            uint32_t old = state_.load(std::memory_order_relaxed);
+            if (!(old & (FUTEX_RW_WRITER_BIT | FUTEX_RW_PENDING_BIT))) {
+                if (state_.compare_exchange_weak(old, old + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    if (spun <= limit) spin_.update(spun);
+                    return;
+                }
+                continue;
+            }
+            if (spun < limit) {
+                ++spun;
+                AdaptiveSpin::pause();
+                continue;
+            }
+            if (spun == limit) {
+                spin_.miss();
+                ++spun;
+            }
+            wait_until([](uint32_t s) { return !(s & (FUTEX_RW_WRITER_BIT | FUTEX_RW_PENDING_BIT)); });
+        }
+    }
+
+    void lock_slow() {
+        uint32_t limit = spin_.limit();
+        uint32_t spun = 0;
+        while (true) {
+            uint32_t old = state_.load(std::memory_order_relaxed);
+            if (!(old & (FUTEX_RW_WRITER_BIT | FUTEX_RW_READER_MASK))) {
+                // clears pending bit; other waiting writers set it again
+                if (state_.compare_exchange_weak(old, FUTEX_RW_WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    if (spun <= limit) spin_.update(spun);
+                    return;
+                }
+                continue;
+            }
+            if (!(old & FUTEX_RW_PENDING_BIT)) {
+                state_.fetch_or(FUTEX_RW_PENDING_BIT, std::memory_order_seq_cst);
+            }
+            if (spun < limit) {
+                ++spun;
+                AdaptiveSpin::pause();
+                continue;
+            }
+            if (spun == limit) {
+                spin_.miss();
+                ++spun;
+            }
+            wait_until([](uint32_t s) { return !(s & (FUTEX_RW_WRITER_BIT | FUTEX_RW_READER_MASK)); });
+        }
+    }
+
+    // ready(state_)가 참이 될 수 있을 때까지 잠듦 (spurious wake-up 허용, 호출자가 재확인)
+    template <typename Ready>
+    inline void wait_until(Ready ready) {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        uint32_t seq = wake_seq_.load(std::memory_order_seq_cst);
+        if (!ready(state_.load(std::memory_order_seq_cst))) {
+            syscall(SYS_futex, &wake_seq_, FUTEX_WAIT_PRIVATE, seq, nullptr, nullptr, 0);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // 잠든 스레드가 있을 때만 전부 깨움
+    inline void wake_waiters() {
+        if (waiters_.load(std::memory_order_seq_cst) > 0) {
+            wake_seq_.fetch_add(1, std::memory_order_seq_cst);
+            syscall(SYS_futex, &wake_seq_, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+        }
+    }
+};
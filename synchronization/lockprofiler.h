@@ -0,0 +1,303 @@
+/*
+ * LockProfiler: Compile-Time Opt-In Lock Contention Profiler (SpinLock / RWSpinLock)
+ *
+ * 특징:
+ *  - LOCK_PROFILE 매크로를 정의하고 빌드했을 때만 동작 (g++ -DLOCK_PROFILE ...)
+ *      * 미정의 시 LOCK_PROF_* 매크로가 모두 빈 문장으로 치환되고 락 객체에 멤버도 추가되지 않음 → 오버헤드 0
+ *  - 락 인스턴스별 수집 항목
+ *      * acquisitions: 획득 횟수 (try_lock 성공 포함), contended: 한 번 이상 backoff 한 획득 횟수
+ *      * spins: backoff 호출 횟수 합
+ *      * wait / max_wait: 획득까지 걸린 사이클 합 / 최댓값 (x86: rdtsc, 그 외: steady_clock ns)
+ *      * hold / max_hold: 보유 사이클 합 / 최댓값 (shared 보유 포함)
+ *  - 카운터는 스레드별 테이블(ThreadLockStats)에 기록 → hot path에서 다른 코어와 캐시 라인 공유 없음
+ *      * collect() / dump() 호출 시 모든 스레드 테이블 + 종료된 스레드 누적값을 합산
+ *      * 같은 이름의 락(예: flow-table 버킷 락들)은 한 줄로 합쳐서 출력
+ *  - 락 이름은 락의 set_name(name)으로 지정, 미지정 시 종류 이름("spinlock", "rwspinlock")
+ *
+ * 주의:
+ *  - 프로파일 대상 락 인스턴스는 최대 LOCK_PROFILE_MAX_LOCKS개 (초과분은 수집하지 않음), id는 재사용하지 않음
+ *  - 프로파일 빌드에서는 스레드마다 LOCK_PROFILE_MAX_LOCKS * 64 바이트 테이블을 할당한다.
+ *  - reset()은 다른 스레드의 기록과 겹치면 일부 값이 남을 수 있다. (근사치)
+ *  - 같은 스레드가 같은 RWSpinLock을 shared로 중첩 보유하면 hold 값이 부정확하다.
+ *
+ * 사용 예시:
+ *  SpinLock lock;
+ *  lock.set_name("arp_table");
+ *  ...
+ *  LockProfiler::instance().dump();   // LOCK_PROFILE 빌드에서만
+ */
+
+#pragma once
+
+#if defined(LOCK_PROFILE)
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifndef LOCK_PROFILE_MAX_LOCKS
+#define LOCK_PROFILE_MAX_LOCKS 4096
+#endif
+#define LOCK_PROFILE_NONE UINT32_MAX // 수집하지 않는 락 id
+
+static inline uint64_t lock_prof_tsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// 스레드 하나가 락 하나에 대해 기록하는 카운터 (소유 스레드만 씀)
+struct alignas(64) LockStat {
+    std::atomic<uint64_t> acquisitions_;
+    std::atomic<uint64_t> contended_;
+    std::atomic<uint64_t> spins_;
+    std::atomic<uint64_t> wait_cycles_;
+    std::atomic<uint64_t> max_wait_cycles_;
+    std::atomic<uint64_t> hold_cycles_;
+    std::atomic<uint64_t> max_hold_cycles_;
+    uint64_t shared_start_; // shared 보유 시작 시각 (소유 스레드 전용)
+};
+
+struct LockProfileSnapshot {
+    std::string name_;
+    uint32_t locks_;
+    uint64_t acquisitions_;
+    uint64_t contended_;
+    uint64_t spins_;
+    uint64_t wait_cycles_;
+    uint64_t max_wait_cycles_;
+    uint64_t hold_cycles_;
+    uint64_t max_hold_cycles_;
+};
+
+class LockProfiler;
+
+// 스레드별 카운터 테이블, 스레드 종료 시 누적값을 LockProfiler로 넘기고 해제
+struct ThreadLockStats {
+    LockStat* stats_;
+    uint64_t spin_cnt_; // backoff 누적 호출 수 (LockProbe가 차이로 계산)
+    ThreadLockStats();
+    ~ThreadLockStats();
+};
+
+class LockProfiler {
+private:
+    std::atomic<uint32_t> next_id_;
+    std::mutex mtx_; // names_, threads_, retired_ 보호
+    std::vector<std::string> names_;
+    std::vector<ThreadLockStats*> threads_;
+    std::vector<LockProfileSnapshot> retired_; // 종료된 스레드 누적값 (id별)
+
+    LockProfiler() : next_id_(0), names_(LOCK_PROFILE_MAX_LOCKS), retired_(LOCK_PROFILE_MAX_LOCKS) {}
+
+public:
+    // 스레드 종료 시점에도 안전하도록 해제하지 않는 전역 인스턴스
+    static LockProfiler& instance() {
+        static LockProfiler* inst = new LockProfiler();
+        return *inst;
+    }
+    static inline ThreadLockStats& local() {
+        static thread_local ThreadLockStats tls;
+        return tls;
+    }
+
+    // 락 인스턴스 등록, id 반환 (LOCK_PROFILE_NONE: 한도 초과)
+    uint32_t register_lock(const char* name) {
+        uint32_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
+        if (id >= LOCK_PROFILE_MAX_LOCKS) return LOCK_PROFILE_NONE;
+        set_name(id, name);
+        return id;
+    }
+    void set_name(uint32_t id, const char* name) {
+        if (id == LOCK_PROFILE_NONE) return;
+        std::lock_guard<std::mutex> lock(mtx_);
+        names_[id] = name;
+    }
+
+    void attach(ThreadLockStats* tls) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        threads_.push_back(tls);
+    }
+    void detach(ThreadLockStats* tls) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (uint32_t id = 0; id < LOCK_PROFILE_MAX_LOCKS; ++id) merge(retired_[id], tls->stats_[id]);
+        for (auto it = threads_.begin(); it != threads_.end(); ++it) {
+            if (*it == tls) {
+                threads_.erase(it);
+                break;
+            }
+        }
+    }
+
+    // 모든 스레드 카운터를 합산, 같은 이름끼리 묶어서 반환 (acquisitions 0인 항목 제외)
+    std::vector<LockProfileSnapshot> collect() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        uint32_t cnt = std::min<uint32_t>(next_id_.load(std::memory_order_relaxed), LOCK_PROFILE_MAX_LOCKS);
+        std::map<std::string, LockProfileSnapshot> by_name;
+        for (uint32_t id = 0; id < cnt; ++id) {
+            LockProfileSnapshot s = retired_[id];
+            for (ThreadLockStats* tls : threads_) merge(s, tls->stats_[id]);
+            if (s.acquisitions_ == 0) continue;
+            LockProfileSnapshot& dst = by_name[names_[id]];
+            dst.name_ = names_[id];
+            dst.locks_ += 1;
+            dst.acquisitions_ += s.acquisitions_;
+            dst.contended_ += s.contended_;
+            dst.spins_ += s.spins_;
+            dst.wait_cycles_ += s.wait_cycles_;
+            dst.hold_cycles_ += s.hold_cycles_;
+            if (s.max_wait_cycles_ > dst.max_wait_cycles_) dst.max_wait_cycles_ = s.max_wait_cycles_;
+            if (s.max_hold_cycles_ > dst.max_hold_cycles_) dst.max_hold_cycles_ = s.max_hold_cycles_;
+        }
+        std::vector<LockProfileSnapshot> out;
+        for (auto& entry : by_name) out.push_back(entry.second);
+        return out;
+    }
+
+    // 이름별 한 줄 요약 출력
+    void dump(std::ostream& os = std::cout) {
+        std::vector<LockProfileSnapshot> snaps = collect();
+        for (const LockProfileSnapshot& s : snaps) {
+            os << "[LOCK] " << s.name_
+            << " locks=" << s.locks_
+            << " acquisitions=" << s.acquisitions_
+            << " contended=" << s.contended_
+            << " spins=" << s.spins_
+            << " avg_wait=" << (s.acquisitions_ ? s.wait_cycles_ / s.acquisitions_ : 0)
+            << " max_wait=" << s.max_wait_cycles_
+            << " avg_hold=" << (s.acquisitions_ ? s.hold_cycles_ / s.acquisitions_ : 0)
+            << " max_hold=" << s.max_hold_cycles_ << '\n';
+        }
+    }
+
+    // 모든 카운터 초기화 (근사치, 기록 중인 스레드와 겹칠 수 있음)
+    void reset() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (uint32_t id = 0; id < LOCK_PROFILE_MAX_LOCKS; ++id) {
+            retired_[id] = LockProfileSnapshot();
+            for (ThreadLockStats* tls : threads_) clear(tls->stats_[id]);
+        }
+    }
+
+private:
+    static void merge(LockProfileSnapshot& dst, const LockStat& src) {
+        dst.acquisitions_ += src.acquisitions_.load(std::memory_order_relaxed);
+        dst.contended_ += src.contended_.load(std::memory_order_relaxed);
+        dst.spins_ += src.spins_.load(std::memory_order_relaxed);
+        dst.wait_cycles_ += src.wait_cycles_.load(std::memory_order_relaxed);
+        dst.hold_cycles_ += src.hold_cycles_.load(std::memory_order_relaxed);
+        uint64_t mw = src.max_wait_cycles_.load(std::memory_order_relaxed);
+        uint64_t mh = src.max_hold_cycles_.load(std::memory_order_relaxed);
+        if (mw > dst.max_wait_cycles_) dst.max_wait_cycles_ = mw;
+        if (mh > dst.max_hold_cycles_) dst.max_hold_cycles_ = mh;
+    }
+    static void clear(LockStat& s) {
+        s.acquisitions_.store(0, std::memory_order_relaxed);
+        s.contended_.store(0, std::memory_order_relaxed);
+        s.spins_.store(0, std::memory_order_relaxed);
+        s.wait_cycles_.store(0, std::memory_order_relaxed);
+        s.max_wait_cycles_.store(0, std::memory_order_relaxed);
+        s.hold_cycles_.store(0, std::memory_order_relaxed);
+        s.max_hold_cycles_.store(0, std::memory_order_relaxed);
+    }
+};
+
+inline ThreadLockStats::ThreadLockStats() : stats_(new LockStat[LOCK_PROFILE_MAX_LOCKS]()), spin_cnt_(0) {
+    LockProfiler::instance().attach(this);
+}
+inline ThreadLockStats::~ThreadLockStats() {
+    LockProfiler::instance().detach(this);
+    delete[] stats_;
+}
+
+// 락 획득 한 번을 측정 (생성 시각 → acquired() 시각 = 대기, backoff 횟수 = spin)
+class LockProbe {
+private:
+    uint32_t id_;
+    uint64_t start_;
+    uint64_t spin_start_;
+
+    // 소유 스레드 전용 카운터 갱신 (RMW 없이 load + store)
+    static inline void add(std::atomic<uint64_t>& c, uint64_t v) {
+        c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+    static inline void max(std::atomic<uint64_t>& c, uint64_t v) {
+        if (v > c.load(std::memory_order_relaxed)) c.store(v, std::memory_order_relaxed);
+    }
+
+public:
+    explicit LockProbe(uint32_t id) : id_(id), start_(0), spin_start_(0) {
+        if (id_ == LOCK_PROFILE_NONE) return;
+        spin_start_ = LockProfiler::local().spin_cnt_;
+        start_ = lock_prof_tsc();
+    }
+    // 획득 기록, 보유 시작 시각 반환
+    inline uint64_t acquired() {
+        if (id_ == LOCK_PROFILE_NONE) return 0;
+        uint64_t now = lock_prof_tsc();
+        ThreadLockStats& tls = LockProfiler::local();
+        LockStat& s = tls.stats_[id_];
+        uint64_t spins = tls.spin_cnt_ - spin_start_;
+        uint64_t wait = now - start_;
+        add(s.acquisitions_, 1);
+        if (spins > 0) {
+            add(s.contended_, 1);
+            add(s.spins_, spins);
+        }
+        add(s.wait_cycles_, wait);
+        max(s.max_wait_cycles_, wait);
+        return now;
+    }
+    inline void acquired_shared() {
+        uint64_t now = acquired();
+        if (id_ != LOCK_PROFILE_NONE) LockProfiler::local().stats_[id_].shared_start_ = now;
+    }
+    // 해제 기록 (exclusive: 락 멤버에 저장한 시작 시각 사용)
+    static inline void released(uint32_t id, uint64_t hold_start) {
+        if (id == LOCK_PROFILE_NONE) return;
+        uint64_t hold = lock_prof_tsc() - hold_start;
+        LockStat& s = LockProfiler::local().stats_[id];
+        add(s.hold_cycles_, hold);
+        max(s.max_hold_cycles_, hold);
+    }
+    static inline void released_shared(uint32_t id) {
+        if (id == LOCK_PROFILE_NONE) return;
+        released(id, LockProfiler::local().stats_[id].shared_start_);
+    }
+    static inline void spin() { ++LockProfiler::local().spin_cnt_; }
+};
+
+#define LOCK_PROF_MEMBERS uint32_t prof_id_; uint64_t prof_hold_start_;
+#define LOCK_PROF_INIT(kind) do { prof_id_ = LockProfiler::instance().register_lock(kind); prof_hold_start_ = 0; } while (0)
+#define LOCK_PROF_NAME(name) LockProfiler::instance().set_name(prof_id_, name)
+#define LOCK_PROF_BEGIN() LockProbe lock_probe_(prof_id_)
+#define LOCK_PROF_SPIN() LockProbe::spin()
+#define LOCK_PROF_ACQUIRED() (prof_hold_start_ = lock_probe_.acquired())
+#define LOCK_PROF_ACQUIRED_SHARED() lock_probe_.acquired_shared()
+#define LOCK_PROF_RELEASE() LockProbe::released(prof_id_, prof_hold_start_)
+#define LOCK_PROF_RELEASE_SHARED() LockProbe::released_shared(prof_id_)
+
+#else // LOCK_PROFILE 미정의: 모든 계측 제거
+
+#define LOCK_PROF_MEMBERS
+#define LOCK_PROF_INIT(kind) do {} while (0)
+#define LOCK_PROF_NAME(name) (void)(name)
+#define LOCK_PROF_BEGIN() do {} while (0)
+#define LOCK_PROF_SPIN() do {} while (0)
+#define LOCK_PROF_ACQUIRED() do {} while (0)
+#define LOCK_PROF_ACQUIRED_SHARED() do {} while (0)
+#define LOCK_PROF_RELEASE() do {} while (0)
+#define LOCK_PROF_RELEASE_SHARED() do {} while (0)
+
+#endif
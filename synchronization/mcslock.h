@@ -0,0 +1,158 @@
+/*
+ * MCSLock: Mellor-Crummey & Scott Queue Spin Lock
+ *
+ * 특징:
+ *  - 대기 스레드들이 tail_ 포인터로 연결된 FIFO 대기열을 구성
+ *  - 각 대기자는 자기 노드(MCSNode)의 locked_ 플래그만 스핀 → 대기자마다 서로 다른 캐시 라인에서 대기
+ *      * SpinLock(test_and_set)처럼 모든 대기자가 하나의 캐시 라인을 두드리지 않으므로
+ *        코어 수가 늘어도 handoff 비용이 일정하게 유지됨
+ *  - 도착 순서대로 락을 넘겨받는 FIFO 공정성 보장
+ *  - SpinLock과 동일한 lock()/unlock()/try_lock() API (std::lock_guard 등과 호환)
+ *  - 노드는 스레드별 thread_local 풀(MCS_MAX_NEST개)에서 꺼내 사용 → 호출자가 노드를 넘길 필요 없음
+ *      * 서로 다른 MCSLock을 중첩해서 잡을 수 있고, 해제 순서는 자유
+ *      * 풀이 모두 사용 중이면 힙에서 노드를 할당하여 계속 동작
+ *  - MCS_SPIN_YIELD 회 이상 스핀하면 yield → 과구독(스레드 수 > 코어 수) 환경에서 선점된 대기자로 인한 정체 완화
+ *  - 64바이트 캐시 라인 정렬로 false sharing 최소화
+ *
+ * 메모리 오더링:
+ *  - lock(): tail_ exchange(acq_rel) → 선행 노드 next_ 연결(release) → 자기 locked_ acquire 스핀
+ *  - unlock(): 후속 노드 locked_ = false (release), 후속이 없으면 tail_ CAS(release)로 비움
+ *  - try_lock(): tail_이 nullptr일 때만 CAS로 즉시 획득
+ *
+ * 주의:
+ *  - lock()을 호출한 스레드가 unlock()을 호출해야 한다. (노드가 스레드 로컬)
+ *  - 같은 MCSLock을 재귀적으로 잡을 수 없다.
+ *  - 대기자가 없을 때의 획득/해제 비용은 SpinLock보다 약간 크다. (exchange + CAS)
+ *
+ * 사용 예시:
+ *  MCSLock lock;
+ *  lock.lock();
+ *  // critical section
+ *  lock.unlock();
+ */
+
+#pragma once
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#endif
+
+#define MCS_MAX_NEST 8      // 스레드당 동시에 보유/대기 가능한 MCSLock 수 (초과 시 힙 노드 사용)
+#define MCS_SPIN_YIELD 1024 // 이 횟수만큼 pause 스핀 후 yield
+
+struct alignas(64) MCSNode {
+    std::atomic<MCSNode*> next_; // 후속 대기자
+    std::atomic<bool> locked_;   // true: 대기 중, false: 락 획득
+    bool in_use_;                // 스레드 로컬 풀 사용 여부
+    bool heap_;                  // 풀 부족으로 힙에서 할당된 노드
+};
+
+class alignas(64) MCSLock {
+private:
+    std::atomic<MCSNode*> tail_; // 대기열 마지막 노드 (nullptr = unlocked)
+    MCSNode* holder_;            // 현재 보유자 노드 (보유자만 읽고 씀)
+
+public:
+    MCSLock() : tail_(nullptr), holder_(nullptr) {}
+    MCSLock(const MCSLock&) = delete;
+    MCSLock& operator=(const MCSLock&) = delete;
+
+    // 락 획득 (blocking)
+    inline void lock() {
+        MCSNode* node = acquire_node();
+        node->next_.store(nullptr, std::memory_order_relaxed);
+        node->locked_.store(true, std::memory_order_relaxed);
+        MCSNode* prev = tail_.exchange(node, std::memory_order_acq_rel);
+        if (prev != nullptr) {
+            prev->next_.store(node, std::memory_order_release);
+            uint32_t spin = 0;
+            while (node->locked_.load(std::memory_order_acquire)) {
+                backoff(spin);
+            }
+        }
+        holder_ = node;
+    }
+
+    // 락 해제
+    inline void unlock() {
+        MCSNode* node = holder_;
+        MCSNode* next = node->next_.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            MCSNode* expected = node;
+            if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) {
+                release_node(node);
+                return;
+            }
+            // 후속 대기자가 tail_ 교체 후 next_ 연결 중 → 연결될 때까지 대기
+            uint32_t spin = 0;
+            while ((next = node->next_.load(std::memory_order_acquire)) == nullptr) {
+                backoff(spin);
+            }
+        }
+        next->locked_.store(false, std::memory_order_release);
+        release_node(node);
+    }
+
+    // 비차단 try-lock (대기열이 비어 있을 때만 획득, 실패 시 false)
+    inline bool try_lock() {
+        if (tail_.load(std::memory_order_relaxed) != nullptr) return false;
+        MCSNode* node = acquire_node();
+        node->next_.store(nullptr, std::memory_order_relaxed);
+        node->locked_.store(false, std::memory_order_relaxed);
+        MCSNode* expected = nullptr;
+        if (!tail_.compare_exchange_strong(expected, node, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            release_node(node);
+            return false;
+        }
+        holder_ = node;
+        return true;
+    }
+
+private:
+    // 스레드 로컬 풀에서 빈 노드 확보, 없으면 힙 할당
+    static inline MCSNode* acquire_node() {
+        MCSNode* pool = node_pool();
+        for (uint32_t i = 0; i < MCS_MAX_NEST; ++i) {
+            if (!pool[i].in_use_) {
+                pool[i].in_use_ = true;
+                pool[i].heap_ = false;
+                return &pool[i];
+            }
+        }
+        MCSNode* node = new MCSNode();
+        node->in_use_ = true;
+        node->heap_ = true;
+        return node;
+    }
+    static inline void release_node(MCSNode* node) {
+        if (node->heap_) {
+            delete node;
+            return;
+        }
+        node->in_use_ = false;
+    }
+    static inline MCSNode* node_pool() {
+        static thread_local MCSNode pool[MCS_MAX_NEST] = {};
+        return pool;
+    }
+
+    // CPU별 pause 백오프, MCS_SPIN_YIELD 회 초과 시 yield
+    static inline void backoff(uint32_t& spin) {
+        if (++spin >= MCS_SPIN_YIELD) {
+            spin = 0;
+            std::this_thread::yield();
+            return;
+        }
+    #if defined(_MSC_VER)
+        _mm_pause();
+    #elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+    #elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+    #elif defined(__riscv)
+        __asm__ __volatile__("pause");
+    #endif
+    }
+};
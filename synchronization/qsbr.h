@@ -0,0 +1,164 @@
+/*
+ * QSBRDomain: Quiescent-State-Based Memory Reclamation
+ *
+ * 특징:
+ *  - lock-free 구조에서 unlink한 노드를 "모든 스레드가 더 이상 참조하지 않을 때" 해제
+ *      * 참조 스레드는 thread_loop 한 바퀴가 끝날 때처럼 노드 포인터를 들고 있지 않은 지점에서 quiescent() 호출
+ *      * retire(ptr, deleter)로 넘긴 노드는 retire 이후 모든 online 스레드가 quiescent()를 한 번씩 지나면 해제
+ *      → stop-the-world 없이 동작 중에 삭제 가능 (hash table / list / MPMC 노드 등)
+ *  - 전역 epoch_ + 스레드별 레코드(QSBRRecord, 64바이트 캐시 라인 하나씩)
+ *      * retire(): epoch_ 증가 후 노드에 새 epoch 기록
+ *      * quiescent(): 현재 epoch_를 자기 레코드에 기록 (load 1회 + 로컬 store 1회, RMW 없음)
+ *      * reclaim(): online 레코드의 최소 epoch 이하로 기록된 노드만 해제
+ *  - offline()/online(): 오래 block 되는 구간(epoll_wait, futex 등)에서 해제를 막지 않도록 일시적으로 빠짐
+ *  - 대기 중인 retire 노드가 QSBR_RECLAIM_THRESHOLD 개 이상이면 retire() 안에서 자동으로 reclaim()
+ *  - Thread::set_qsbr_domain() / ThreadPool::set_qsbr_domain()으로 연결하면 스레드 시작 시 자동 등록,
+ *    thread_loop 종료 시 자동 해제 (thread_loop 에서는 quiescent()만 호출)
+ *
+ * 메모리 오더링:
+ *  - retire(): epoch_ fetch_add(acq_rel) → unlink가 새 epoch보다 먼저 보임
+ *  - quiescent(): epoch_ acquire load → 레코드 release store (이전 참조가 레코드 갱신보다 먼저 끝남)
+ *  - reclaim(): 레코드 acquire load → deleter 호출 (참조 스레드의 접근이 해제보다 먼저 일어남)
+ *
+ * 주의:
+ *  - quiescent() 호출 시점에 이 도메인으로 보호되는 노드 포인터를 들고 있으면 안 된다.
+ *  - online 상태에서 quiescent()를 호출하지 않는 스레드가 있으면 해제가 진행되지 않는다. (메모리 증가)
+ *  - 등록 가능한 스레드 수는 QSBR_MAX_THREADS 개, 초과 시 register_thread()가 -1 반환
+ *  - 도메인 파괴 시 남은 노드는 모두 해제되므로, 그 전에 참조 스레드가 모두 종료되어야 한다.
+ *
+ * 사용 예시:
+ *  QSBRDomain qsbr;
+ *  pool.set_qsbr_domain(&qsbr);                 // start_pool() 전
+ *  // worker thread_loop: while (!thread_term_) { lookup(...); quiescent(); }
+ *  unlink(node); qsbr.retire(node);             // 임의 스레드에서 삭제
+ */
+
+#pragma once
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include "spinlock.h"
+
+#define QSBR_MAX_THREADS 128         // 등록 가능한 최대 스레드 수
+#define QSBR_RECLAIM_THRESHOLD 64    // 대기 중인 retire 노드가 이 수 이상이면 retire()에서 reclaim()
+#define QSBR_OFFLINE 0               // 레코드 epoch 값: offline (해제 조건에서 제외)
+
+struct alignas(64) QSBRRecord {
+    std::atomic<uint64_t> epoch_; // 마지막 quiescent 시점의 epoch (QSBR_OFFLINE: offline)
+    std::atomic<bool> in_use_;    // 레코드 할당 여부
+};
+
+class QSBRDomain {
+private:
+    struct Retired {
+        void* ptr_;
+        void (*deleter_)(void*);
+        uint64_t epoch_; // retire 시점 epoch
+    };
+
+    alignas(64) std::atomic<uint64_t> epoch_;
+    QSBRRecord records_[QSBR_MAX_THREADS];
+    alignas(64) SpinLock retired_lock_; // retired_ 보호
+    std::vector<Retired> retired_;
+
+public:
+    QSBRDomain() : epoch_(1) {
+        for (uint32_t i = 0; i < QSBR_MAX_THREADS; ++i) {
+            records_[i].epoch_.store(QSBR_OFFLINE, std::memory_order_relaxed);
+            records_[i].in_use_.store(false, std::memory_order_relaxed);
+        }
+    }
+    ~QSBRDomain() {
+        for (const Retired& r : retired_) r.deleter_(r.ptr_);
+    }
+    QSBRDomain(const QSBRDomain&) = delete;
+    QSBRDomain& operator=(const QSBRDomain&) = delete;
+
+    // 호출 스레드를 online 상태로 등록, 레코드 번호 반환 (-1: 레코드 부족)
+    int32_t register_thread() {
+        for (uint32_t i = 0; i < QSBR_MAX_THREADS; ++i) {
+            bool expected = false;
+            if (!records_[i].in_use_.load(std::memory_order_relaxed)
+                && records_[i].in_use_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                online(static_cast<int32_t>(i));
+                return static_cast<int32_t>(i);
+            }
+        }
+        std::cerr << "[ERROR] no free qsbr record "
+        << "(QSBRDomain::register_thread) " << '\n';
+        return -1;
+    }
+    // 레코드 반납 (offline 후 해제)
+    void unregister_thread(int32_t idx) {
+        offline(idx);
+        records_[idx].in_use_.store(false, std::memory_order_release);
+    }
+
+    // 보호 노드 참조를 모두 내려놓은 지점에서 호출
+    inline void quiescent(int32_t idx) {
+        records_[idx].epoch_.store(epoch_.load(std::memory_order_acquire), std::memory_order_release);
+    }
+    // block 구간 진입 전 호출 (이후 보호 노드 참조 금지)
+    inline void offline(int32_t idx) {
+        records_[idx].epoch_.store(QSBR_OFFLINE, std::memory_order_release);
+    }
+    // block 구간 종료 후 호출 (이후 보호 노드 참조 가능)
+    inline void online(int32_t idx) {
+        records_[idx].epoch_.store(epoch_.load(std::memory_order_acquire), std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    // unlink 완료된 노드 해제 예약 (deleter 미지정 시 delete)
+    template <typename T>
+    void retire(T* ptr) {
+        retire(static_cast<void*>(ptr), [](void* p) { delete static_cast<T*>(p); });
+    }
+    void retire(void* ptr, void (*deleter)(void*)) {
+        uint64_t epoch = epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        size_t pending;
+        retired_lock_.lock();
+        retired_.push_back({ptr, deleter, epoch});
+        pending = retired_.size();
+        retired_lock_.unlock();
+        if (pending >= QSBR_RECLAIM_THRESHOLD) reclaim();
+    }
+
+    // 모든 online 스레드가 지나간 노드 해제, 해제한 노드 수 반환
+    size_t reclaim() {
+        uint64_t safe = min_epoch();
+        std::vector<Retired> ready;
+        retired_lock_.lock();
+        size_t keep = 0;
+        for (size_t i = 0; i < retired_.size(); ++i) {
+            if (retired_[i].epoch_ <= safe) ready.push_back(retired_[i]);
+            else retired_[keep++] = retired_[i];
+        }
+        retired_.resize(keep);
+        retired_lock_.unlock();
+        for (const Retired& r : ready) r.deleter_(r.ptr_);
+        return ready.size();
+    }
+
+    // 해제 대기 중인 노드 수
+    size_t get_pending() {
+        retired_lock_.lock();
+        size_t n = retired_.size();
+        retired_lock_.unlock();
+        return n;
+    }
+    uint64_t get_epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+private:
+    // online 레코드 중 최소 epoch (online 스레드가 없으면 현재 epoch)
+    uint64_t min_epoch() {
+        uint64_t safe = epoch_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst); // online()과 짝: offline으로 읽힌 스레드는 이후 unlink를 관찰
+        for (uint32_t i = 0; i < QSBR_MAX_THREADS; ++i) {
+            if (!records_[i].in_use_.load(std::memory_order_acquire)) continue;
+            uint64_t e = records_[i].epoch_.load(std::memory_order_acquire);
+            if (e != QSBR_OFFLINE && e < safe) safe = e;
+        }
+        return safe;
+    }
+};
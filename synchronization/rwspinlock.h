@@ -2,16 +2,25 @@
  * RWSpinLock: High-Performance Reader-Writer Spin Lock
  *
  * 특징:
- *  - 단일 32비트 원자 변수(state_) 기반으로 읽기/쓰기 상태 관리
+ *  - 생성 시 RWLockMode로 writer / reader 우선순위 정책 선택
+ *      * RW_READER_PREFER (기본): 기존 동작, 리더가 있으면 writer는 모든 리더가 빠질 때까지 대기 (writer starvation 가능)
+ *      * RW_WRITER_PREFER: 대기 중인 writer가 WRITER_PENDING_BIT를 세워 새 리더 진입 차단
+ *          → 이미 들어온 리더만 빠지면 writer가 획득, 리더가 끊임없이 들어와도 writer 지연이 유한
+ *      * RW_PHASE_FAIR: 리더 phase와 writer phase를 번갈아 진행 (Brandenburg & Anderson PF-T)
+ *          → writer는 먼저 들어온 리더들만 기다리고, 리더는 최대 한 번의 writer phase만 기다림
+ *          → 리더 / writer 모두 starvation 없음, writer끼리는 번호표로 FIFO
+ *  - RW_READER_PREFER / RW_WRITER_PREFER: 단일 32비트 원자 변수(state_) 기반으로 읽기/쓰기 상태 관리
  *      * 최상위 비트: 쓰기(lock) 플래그
- *      * 나머지 31비트: 읽기(reader) 카운터 (최대 2,147,483,647명 동시 리더 지원)
+ *      * 다음 비트: 쓰기 대기(pending) 플래그
+ *      * 나머지 30비트: 읽기(reader) 카운터 (최대 1,073,741,823명 동시 리더 지원)
+ *  - RW_PHASE_FAIR: rin_/rout_(리더 진입/퇴장 카운터, 하위 8비트는 writer phase 정보) + win_/wout_(writer 번호표)
  *  - lock_shared()/unlock_shared(): reader 획득 및 해제
  *  - lock()/unlock(): writer 획득 및 해제
- *  - compare_exchange_weak 기반 CAS 반복으로 lock 획득
+ *  - 경합이 없는 리더 경로는 CAS(또는 fetch_add) 한 번으로 끝남 (route/ARP 테이블 조회 등)
  *  - 64바이트 캐시 라인 정렬으로 false sharing 최소화
  *  - 순수 스핀락 기반, 커널 블록킹 없음
  *  - 짧은 임계 구간에서 높은 성능 제공
- *  - starvation 방지 로직 없음(읽기 지속 시 writer 대기 가능)
+ *  - LOCK_PROFILE 빌드 시 획득/스핀/대기/보유 시간 계측 (lockprofiler.h, 미정의 시 오버헤드 0)
  *  - backoff()에서 아키텍처별 CPU pause 명령 사용
  *      * Windows: _mm_pause()
  *      * x86/x64 GCC/Clang: __builtin_ia32_pause()
@@ -26,32 +35,113 @@
  * 주의:
  *  - 락 구간이 길거나 스레드 수가 매우 많을 경우 CPU 점유 과다 가능
  *  - modern x86/ARM 환경에서는 std::this_thread::yield() fallback 없음
- *  - 장시간 경합이나 우선순위 보장이 필요한 경우 별도 설계 필요
+ *  - RW_WRITER_PREFER에서 writer가 끊임없이 들어오면 리더가 대기할 수 있음 (양쪽 모두 보장이 필요하면 RW_PHASE_FAIR)
+ *  - RW_WRITER_PREFER / RW_PHASE_FAIR에서는 shared 락을 보유한 스레드가 다시 lock_shared()를 호출하면
+ *    그 사이 대기에 들어간 writer 뒤에서 영원히 스핀한다 (deadlock). 중첩 읽기 락이 필요한 호출자는 기본값(RW_READER_PREFER) 유지
+ *  - RW_PHASE_FAIR는 리더도 공유 카운터에 fetch_add 하므로 리더만 있을 때는 RW_WRITER_PREFER와 비슷한 비용
  *  - 경합이 적고 짧은 임계 구간 환경에서 Folly SharedMutex 대비 빠른 성능 가능
  * 
  */
 
 #pragma once
 #include <atomic>
+#include <cstdint>
 #if defined(_MSC_VER)
 #include <immintrin.h>
 #endif
+#include "lockprofiler.h"
 
 #define WRITER_BIT (1u << 31)
+#define WRITER_PENDING_BIT (1u << 30)
+#define READER_MASK (WRITER_PENDING_BIT - 1)
 #define READER_INC 1u
 
+// RW_PHASE_FAIR 전용 (rin_/rout_ 하위 8비트: writer 존재 + phase id)
+#define PF_READER_INC 0x100u
+#define PF_WRITER_BITS 0x3u
+#define PF_WRITER_PRESENT 0x2u
+#define PF_PHASE_ID 0x1u
+
+enum RWLockMode {
+    RW_READER_PREFER,
+    RW_WRITER_PREFER,
+    RW_PHASE_FAIR
+};
+
 class alignas(64) RWSpinLock {
 private:
     std::atomic<uint32_t> state_;
+    // RW_PHASE_FAIR state
+    std::atomic<uint32_t> rin_;  // reader arrivals (upper 24 bits) | writer present + phase id (lower bits)
+    std::atomic<uint32_t> rout_; // reader departures
+    std::atomic<uint32_t> win_;  // writer ticket
+    std::atomic<uint32_t> wout_; // writer now serving
+    const RWLockMode mode_;
+    LOCK_PROF_MEMBERS
 public:
-    RWSpinLock():state_(0){};
+    RWSpinLock(RWLockMode mode = RW_READER_PREFER):state_(0), rin_(0), rout_(0), win_(0), wout_(0), mode_(mode){ LOCK_PROF_INIT("rwspinlock"); };
+    RWSpinLock(const RWSpinLock&) = delete;
+    RWSpinLock& operator=(const RWSpinLock&) = delete;
+
+    RWLockMode get_mode() const { return mode_; }
+
+    // 프로파일 출력용 이름 (LOCK_PROFILE 미정의 시 무시)
+    void set_name(const char* name) { LOCK_PROF_NAME(name); }
+
     // Acquire shared (reader) lock
     inline void lock_shared() {
+        LOCK_PROF_BEGIN();
+        acquire_shared();
+        LOCK_PROF_ACQUIRED_SHARED();
+    }
+
+    // Release shared (reader) lock
+    inline void unlock_shared() {
+        LOCK_PROF_RELEASE_SHARED();
+        if (mode_ == RW_PHASE_FAIR) {
+            rout_.fetch_add(PF_READER_INC, std::memory_order_release);
+            return;
+        }
+        state_.fetch_sub(READER_INC, std::memory_order_release);
+    }
+
+    // Acquire exclusive (writer) lock
+    inline void lock() {
+        LOCK_PROF_BEGIN();
+        acquire_exclusive();
+        LOCK_PROF_ACQUIRED();
+    }
+
+    // Release exclusive (writer) lock
+    inline void unlock() {
+        LOCK_PROF_RELEASE();
+        if (mode_ == RW_PHASE_FAIR) {
+            // end writer phase: release blocked readers, then pass to next writer
+            rin_.fetch_and(~PF_WRITER_BITS, std::memory_order_release);
+            wout_.store(wout_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            return;
+        }
+        if (mode_ == RW_WRITER_PREFER) {
+            // keep pending bit set by other waiting writers
+            state_.fetch_and(~WRITER_BIT, std::memory_order_release);
+            return;
+        }
+        state_.store(0, std::memory_order_release);
+    }
+
+private:
+    inline void acquire_shared() {
+        if (mode_ == RW_PHASE_FAIR) {
+            pf_lock_shared();
+            return;
+        }
+        // writer-preferring mode also blocks new readers while a writer is pending
+        const uint32_t block = mode_ == RW_WRITER_PREFER ? (WRITER_BIT | WRITER_PENDING_BIT) : WRITER_BIT;
         uint32_t  old;
         while (true) {
             old = state_.load(std::memory_order_relaxed);
-            // writer active?
-            if (old & WRITER_BIT) {
+            // writer active (or pending)?
+            if (old & block) {
                 backoff();
                 continue;
             }
@@ -63,35 +153,70 @@ public:
         }
     }
 
-    // Release shared (reader) lock
-    inline void unlock_shared() {
-        state_.fetch_sub(READER_INC, std::memory_order_release);
-    }
-
-    // Acquire exclusive (writer) lock
-    inline void lock() {
-        // try to acquire writer bit when no one holds the lock
+    inline void acquire_exclusive() {
+        if (mode_ == RW_PHASE_FAIR) {
+            pf_lock();
+            return;
+        }
+        if (mode_ == RW_READER_PREFER) {
+            // try to acquire writer bit when no one holds the lock
+            while (true) {
+                uint32_t  expected = 0;
+                if (state_.compare_exchange_weak(expected, WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    break;
+                }
+                backoff();
+            }
+            // wait until all readers have exited
+            while (state_.load(std::memory_order_acquire) != WRITER_BIT) {
+                backoff();
+            }
+            return;
+        }
+        // writer-preferring: announce pending writer, then take the lock once readers drain
+        uint32_t old;
         while (true) {
-            uint32_t  expected = 0;
-            if (state_.compare_exchange_weak(expected, WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed)) {
-                break;
+            old = state_.load(std::memory_order_relaxed);
+            if ((old & (WRITER_BIT | READER_MASK)) == 0) {
+                // clears pending bit; other waiting writers set it again
+                if (state_.compare_exchange_weak(old, WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return;
+                }
+                continue;
+            }
+            if (!(old & WRITER_PENDING_BIT)) {
+                state_.fetch_or(WRITER_PENDING_BIT, std::memory_order_relaxed);
             }
             backoff();
         }
-        // wait until all readers have exited
-        while (state_.load(std::memory_order_acquire) != WRITER_BIT) {
+    }
+
+    // phase-fair reader: wait at most one writer phase
+    inline void pf_lock_shared() {
+        uint32_t w = rin_.fetch_add(PF_READER_INC, std::memory_order_acquire) & PF_WRITER_BITS;
+        if (w == 0) return;
+        // writer present: wait until that writer phase ends (writer bits change)
+        while ((rin_.load(std::memory_order_acquire) & PF_WRITER_BITS) == w) {
             backoff();
         }
     }
-
-    // Release exclusive (writer) lock
-    inline void unlock() {
-        state_.store(0, std::memory_order_release);
+    // phase-fair writer: FIFO among writers, waits only for readers that arrived before it
+    inline void pf_lock() {
+        uint32_t ticket = win_.fetch_add(1, std::memory_order_relaxed);
+        while (wout_.load(std::memory_order_acquire) != ticket) {
+            backoff();
+        }
+        uint32_t w = PF_WRITER_PRESENT | (ticket & PF_PHASE_ID);
+        uint32_t readers = rin_.fetch_add(w, std::memory_order_acquire) & ~PF_WRITER_BITS;
+        while (rout_.load(std::memory_order_acquire) != readers) {
+            backoff();
+        }
     }
 
 public:
     // Adaptive backoff: fast pause first, yield if contention persists
     static inline void backoff() {
+        LOCK_PROF_SPIN();
         #if defined(_MSC_VER)
             // MSVC (Windows)
             _mm_pause();
@@ -0,0 +1,113 @@
+/*
+ * SeqLock<T>: Single-Writer / Multi-Reader Sequence Lock
+ *
+ * 특징:
+ *  - 작은 상태 값(T)을 한 writer가 갱신하고 여러 리더가 스냅샷으로 읽는 용도
+ *      * NIC 메타데이터(source ip / mac / mtu), 통계 스냅샷, 공유 설정 값 등
+ *  - writer는 wait-free: seq_를 홀수로 만든 뒤 값 기록, 다시 짝수로 만들면 끝 (리더를 기다리지 않음)
+ *  - 리더는 낙관적 읽기: seq_ 읽기 → 값 복사 → seq_ 재확인, 홀수이거나 값이 바뀌었으면 재시도
+ *      → 리더는 공유 캐시 라인에 쓰지 않으므로 RWSpinLock처럼 리더끼리 캐시 라인을 주고받지 않음
+ *      → 경합 없는 읽기 비용: seq_ load 2회 + 값 복사
+ *  - 값은 8바이트 단위 relaxed atomic 워드로 저장 → 읽기와 쓰기가 겹쳐도 data race(UB) 없음
+ *  - 64바이트 캐시 라인 정렬로 false sharing 최소화
+ *
+ * 메모리 오더링:
+ *  - store(): seq_ = 홀수 (relaxed) → release fence → 값 워드 relaxed store → seq_ = 짝수 (release)
+ *  - load(): seq_ acquire load → 값 워드 relaxed load → acquire fence → seq_ relaxed load 비교
+ *
+ * 주의:
+ *  - T는 trivially copyable 이어야 한다. (Ip / Mac 은 trivially copyable, std::string 등은 불가)
+ *  - writer는 하나여야 한다. 여러 스레드가 store()를 호출하려면 외부에서 직렬화할 것.
+ *  - writer가 계속 갱신하면 리더가 재시도를 반복할 수 있다. (T가 작고 쓰기가 드문 경우에 적합)
+ *  - 리더는 재시도 중 찢어진(torn) 값을 로컬 버퍼에만 복사하며, 검증된 값만 반환한다.
+ *
+ * 사용 예시:
+ *  struct NicInfo { Ip ip_; Mac mac_; int mtu_; };
+ *  SeqLock<NicInfo> nic;
+ *  nic.store({OsUtil::get_source_ip("eth0"), OsUtil::get_source_mac("eth0"), OsUtil::get_source_mtu("eth0")}); // writer
+ *  NicInfo info = nic.load(); // per-packet reader
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#endif
+
+template <typename T>
+class alignas(64) SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock<T> requires trivially copyable T");
+
+private:
+    static constexpr size_t WORD_CNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> seq_;           // 짝수: 안정, 홀수: 쓰기 중
+    std::atomic<uint64_t> data_[WORD_CNT]; // T를 8바이트 워드 단위로 저장
+
+public:
+    SeqLock() : SeqLock(T()) {}
+    explicit SeqLock(const T& init) : seq_(0) {
+        write_words(init);
+    }
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // 값 갱신 (wait-free, 단일 writer)
+    inline void store(const T& val) {
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        write_words(val);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // 일관된 스냅샷 읽기 (쓰기와 겹치면 재시도)
+    inline T load() const {
+        T out;
+        while (!try_load(out)) {
+            backoff();
+        }
+        return out;
+    }
+
+    // 한 번만 시도, 쓰기와 겹치면 false (out은 변경될 수 있음)
+    inline bool try_load(T& out) const {
+        uint32_t seq = seq_.load(std::memory_order_acquire);
+        if (seq & 1) return false;
+        uint64_t buf[WORD_CNT];
+        for (size_t i = 0; i < WORD_CNT; ++i) {
+            buf[i] = data_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != seq) return false;
+        std::memcpy(&out, buf, sizeof(T));
+        return true;
+    }
+
+    // 현재 시퀀스 (짝수: 안정, 값이 바뀌었는지 확인용)
+    inline uint32_t get_seq() const { return seq_.load(std::memory_order_acquire); }
+
+private:
+    inline void write_words(const T& val) {
+        uint64_t buf[WORD_CNT] = {};
+        std::memcpy(buf, &val, sizeof(T));
+        for (size_t i = 0; i < WORD_CNT; ++i) {
+            data_[i].store(buf[i], std::memory_order_relaxed);
+        }
+    }
+
+    static inline void backoff() {
+    #if defined(_MSC_VER)
+        _mm_pause();
+    #elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+    #elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+    #elif defined(__riscv)
+        __asm__ __volatile__("pause");
+    #endif
+    }
+};
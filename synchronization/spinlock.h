@@ -9,6 +9,7 @@
  *  - 커널 블로킹 없음, 완전한 busy-wait 스핀락
  *  - 짧은 임계 구역에서 최고의 성능
  *  - 장시간 경합 시 CPU 점유율 급증 가능
+ *  - LOCK_PROFILE 빌드 시 획득/스핀/대기/보유 시간 계측 (lockprofiler.h, 미정의 시 오버헤드 0)
  *
  * 메모리 오더링:
  *  - lock(): memory_order_acquire
@@ -27,35 +28,47 @@
 #if defined(_MSC_VER)
 #include <immintrin.h>
 #endif
+#include "lockprofiler.h"
 
 class alignas(64) SpinLock {
 private:
     std::atomic_flag flag_;  // 락 상태 플래그 (true = locked)
+    LOCK_PROF_MEMBERS
 
 public:
     // 생성자에서 초기화
-    SpinLock() : flag_(ATOMIC_FLAG_INIT) {}
+    SpinLock() : flag_(ATOMIC_FLAG_INIT) { LOCK_PROF_INIT("spinlock"); }
+
+    // 프로파일 출력용 이름 (LOCK_PROFILE 미정의 시 무시)
+    void set_name(const char* name) { LOCK_PROF_NAME(name); }
 
     // 락 획득 (blocking)
     inline void lock() {
+        LOCK_PROF_BEGIN();
         while (flag_.test_and_set(std::memory_order_acquire)) {
             backoff();
         }
+        LOCK_PROF_ACQUIRED();
     }
 
     // 락 해제
     inline void unlock() {
+        LOCK_PROF_RELEASE();
         flag_.clear(std::memory_order_release);
     }
 
     // 비차단 try-lock (즉시 시도 후 실패 시 false)
     inline bool try_lock() {
-        return !flag_.test_and_set(std::memory_order_acquire);
+        LOCK_PROF_BEGIN();
+        if (flag_.test_and_set(std::memory_order_acquire)) return false;
+        LOCK_PROF_ACQUIRED();
+        return true;
     }
 
 private:
     // CPU별 pause/yield 백오프
     static inline void backoff() {
+        LOCK_PROF_SPIN();
     #if defined(_MSC_VER)
         _mm_pause();
     #elif defined(__x86_64__) || defined(__i386__)
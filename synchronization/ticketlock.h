@@ -0,0 +1,116 @@
+/*
+ * TicketLock: Fair Ticket Spin Lock with Proportional Backoff
+ *
+ * 특징:
+ *  - next_(발급할 번호표) / serving_(현재 처리 중인 번호표) 두 개의 32비트 카운터로 FIFO 순서 보장
+ *      → 먼저 도착한 스레드가 먼저 획득, 특정 스레드의 starvation 없음 (flow-table 버킷 락 등 지연 편차 제거)
+ *  - 비례 백오프(proportional backoff): 대기자는 자기 번호표와 serving_의 거리 × TICKET_BACKOFF_BASE 만큼
+ *    pause 후 다시 확인 → 차례가 먼 대기자일수록 serving_ 캐시 라인을 덜 읽음
+ *  - 누적 pause 횟수가 TICKET_SPIN_YIELD를 넘으면 yield → 과구독 환경에서 선점된 대기자로 인한 정체 완화
+ *  - try_lock(): 대기자가 없을 때만 번호표를 받아 즉시 획득
+ *  - lock_for(timeout) / lock_until(deadline): 제한 시간까지 획득 시도, 실패 시 false
+ *  - SpinLock과 동일한 lock()/unlock()/try_lock() API (std::lock_guard 등과 호환)
+ *  - 64바이트 캐시 라인 정렬로 false sharing 최소화
+ *
+ * 메모리 오더링:
+ *  - lock(): next_ fetch_add(relaxed)로 번호표 발급 → serving_ acquire load로 차례 확인
+ *  - unlock(): serving_ + 1 release store (보유자만 serving_을 씀)
+ *  - try_lock(): next_ == serving_ 일 때만 next_ CAS(acquire)
+ *
+ * 주의:
+ *  - 번호표는 발급 후 취소할 수 없으므로 lock_for()/lock_until()은 번호표를 받지 않고
+ *    대기열 길이에 비례한 백오프로 try_lock()을 반복한다. (시간 제한 획득은 FIFO 순서에 참여하지 않음)
+ *  - 동시에 2^32개 이상의 대기자는 지원하지 않는다.
+ *
+ * 사용 예시:
+ *  TicketLock lock;
+ *  lock.lock();
+ *  // critical section
+ *  lock.unlock();
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#endif
+
+#define TICKET_BACKOFF_BASE 32  // 대기 거리 1당 pause 횟수
+#define TICKET_BACKOFF_MAX 4096 // 한 번에 수행하는 최대 pause 횟수
+#define TICKET_SPIN_YIELD 16384 // 누적 pause 횟수가 이 값을 넘으면 yield
+
+class alignas(64) TicketLock {
+private:
+    std::atomic<uint32_t> next_;    // 다음에 발급할 번호표
+    std::atomic<uint32_t> serving_; // 현재 락을 보유한 번호표
+
+public:
+    TicketLock() : next_(0), serving_(0) {}
+    TicketLock(const TicketLock&) = delete;
+    TicketLock& operator=(const TicketLock&) = delete;
+
+    // 락 획득 (blocking, FIFO)
+    inline void lock() {
+        uint32_t my = next_.fetch_add(1, std::memory_order_relaxed);
+        uint32_t spin = 0;
+        uint32_t cur;
+        while ((cur = serving_.load(std::memory_order_acquire)) != my) {
+            backoff(my - cur, spin);
+        }
+    }
+
+    // 락 해제
+    inline void unlock() {
+        serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // 비차단 try-lock (대기자가 없을 때만 획득, 실패 시 false)
+    inline bool try_lock() {
+        uint32_t cur = serving_.load(std::memory_order_acquire);
+        uint32_t expected = cur;
+        return next_.compare_exchange_strong(expected, cur + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    // timeout 동안 획득 시도, 성공 시 true
+    inline bool lock_for(std::chrono::nanoseconds timeout) {
+        return lock_until(std::chrono::steady_clock::now() + timeout);
+    }
+    // deadline까지 획득 시도, 성공 시 true
+    inline bool lock_until(std::chrono::steady_clock::time_point deadline) {
+        uint32_t spin = 0;
+        while (!try_lock()) {
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+            // 대기열 길이(next_ - serving_)에 비례하여 백오프
+            uint32_t dist = next_.load(std::memory_order_relaxed) - serving_.load(std::memory_order_relaxed);
+            backoff(dist == 0 ? 1 : dist, spin);
+        }
+        return true;
+    }
+
+private:
+    // 대기 거리(dist)에 비례한 pause, 누적 TICKET_SPIN_YIELD 초과 시 yield
+    static inline void backoff(uint32_t dist, uint32_t& spin) {
+        uint32_t n = dist * TICKET_BACKOFF_BASE;
+        if (n > TICKET_BACKOFF_MAX || n / TICKET_BACKOFF_BASE != dist) n = TICKET_BACKOFF_MAX;
+        spin += n;
+        if (spin >= TICKET_SPIN_YIELD) {
+            spin = 0;
+            std::this_thread::yield();
+            return;
+        }
+        for (uint32_t i = 0; i < n; ++i) {
+        #if defined(_MSC_VER)
+            _mm_pause();
+        #elif defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+        #elif defined(__aarch64__) || defined(__arm__)
+            __asm__ __volatile__("yield");
+        #elif defined(__riscv)
+            __asm__ __volatile__("pause");
+        #endif
+        }
+    }
+};
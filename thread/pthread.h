@@ -23,11 +23,19 @@ public:
 			cleanup();
 			return false;
 		}
+		pthread_attr_t attr;
+		if (!ThreadSetup::apply_process(thread_config_) || !ThreadSetup::init_attr(&attr, thread_config_)) {
+			cleanup();
+			return false;
+		}
 		thread_term_.store(false, std::memory_order_release);
-		if (pthread_create(&thread_id_, nullptr, thread_func, this) != 0) {
+		int ret = pthread_create(&thread_id_, &attr, thread_func, this);
+		pthread_attr_destroy(&attr);
+		if (ret != 0) {
 			std::cerr << "[ERROR] pthread_create PThread : "
-			<< strerror(errno)
+			<< strerror(ret)
 			<< "(PThread::start_thread) " << '\n';
+			thread_id_ = 0;
 			cleanup();
 			return false;
 		}
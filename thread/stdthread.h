@@ -22,6 +22,14 @@ public:
             cleanup();
             return false;
         }
+        if (!ThreadSetup::apply_process(thread_config_)) {
+            cleanup();
+            return false;
+        }
+        if (thread_config_.stack_size_ != 0) {
+            std::cerr << "[WARN] stack_size is not supported by std::thread, ignored "
+                << "(STDThread::start_thread) " << '\n';
+        }
         thread_term_.store(false, std::memory_order_release);
         thread_ = std::thread(&Thread::thread_func, this);
         return true;
@@ -42,6 +50,8 @@ public:
     }
     virtual ~STDThread() {};
 protected:
+    // std::thread는 속성을 받을 수 없으므로 affinity / 스케줄링도 스레드 안에서 적용
+    bool apply_thread_config() override { return ThreadSetup::apply_self(thread_config_, true); }
     virtual bool setup() = 0;
     virtual void cleanup() = 0;
     virtual void thread_loop() = 0;
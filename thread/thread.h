@@ -1,13 +1,23 @@
 #pragma once
 #include <atomic>
 #include <iostream>
+#include "qsbr.h"
+#include "threadconfig.h"
 
 class Thread {
 protected:
     std::atomic<bool> thread_term_;
+    QSBRDomain* qsbr_;  // 연결된 reclamation 도메인 (nullptr: 사용 안 함)
+    int32_t qsbr_idx_;  // 스레드 실행 중 할당된 QSBR 레코드 (-1: 미등록)
+    ThreadConfig thread_config_; // start 시 적용할 affinity / 스케줄링 / 이름 등
 public:
-    Thread() : thread_term_(false) {}
+    Thread() : thread_term_(false), qsbr_(nullptr), qsbr_idx_(-1) {}
     bool get_thread_term() { return thread_term_.load(std::memory_order_acquire);  }
+    // start_thread() 전에 호출, 스레드 시작 시 등록 / thread_loop 종료 시 해제
+    void set_qsbr_domain(QSBRDomain* qsbr) { qsbr_ = qsbr; }
+    // start_thread() 전에 호출, 다음 start_thread()부터 적용
+    void set_thread_config(const ThreadConfig& cfg) { thread_config_ = cfg; }
+    const ThreadConfig& get_thread_config() const { return thread_config_; }
     virtual ~Thread() {}
     virtual bool start_thread() = 0;
     virtual void stop_thread() = 0;
@@ -16,15 +26,42 @@ protected:
     static void* thread_func(void* arg) {
         Thread* self = static_cast<Thread*>(arg);
         std::cout << "thread(ID : " << self->get_thread_id() << ") start...\n";
-        try {
-            self->thread_loop();
-        } catch (const std::exception& e) {
-            std::cerr << "[EXCEPT] thread exception: " << e.what() << '\n';
+        bool ready = self->apply_thread_config();
+        if (!ready) {
+            std::cerr << "[ERROR] apply thread config fail, thread(ID : " << self->get_thread_id() << ") "
+            << "(Thread::thread_func) " << '\n';
+        } else if (self->qsbr_ != nullptr) {
+            self->qsbr_idx_ = self->qsbr_->register_thread();
+            if (self->qsbr_idx_ < 0) {
+                ready = false;
+                std::cerr << "[ERROR] qsbr register fail, thread(ID : " << self->get_thread_id() << ") "
+                << "(Thread::thread_func) " << '\n';
+            }
+        }
+        if (!ready) {// thread_loop 없이 종료
             self->thread_term_.store(true, std::memory_order_release);
+        } else {
+            try {
+                self->thread_loop();
+            } catch (const std::exception& e) {
+                std::cerr << "[EXCEPT] thread exception: " << e.what() << '\n';
+                self->thread_term_.store(true, std::memory_order_release);
+            }
+        }
+        if (self->qsbr_idx_ >= 0) {
+            self->qsbr_->unregister_thread(self->qsbr_idx_);
+            self->qsbr_idx_ = -1;
         }
         std::cout << "thread(ID : " << self->get_thread_id() << ") stop!!!\n";
         return nullptr;
     }
+    // 새 스레드 안에서 thread_loop 전에 호출 (PThread는 affinity / 스케줄링을 pthread_attr로 이미 적용)
+    virtual bool apply_thread_config() { return ThreadSetup::apply_self(thread_config_, false); }
+    // thread_loop에서 보호 노드 참조를 모두 내려놓은 지점마다 호출
+    inline void quiescent() { if (qsbr_idx_ >= 0) qsbr_->quiescent(qsbr_idx_); }
+    // 오래 block 되는 구간 전후에 호출 (block 중 해제를 막지 않음)
+    inline void qsbr_offline() { if (qsbr_idx_ >= 0) qsbr_->offline(qsbr_idx_); }
+    inline void qsbr_online() { if (qsbr_idx_ >= 0) qsbr_->online(qsbr_idx_); }
     virtual bool setup() = 0;
     virtual void cleanup() = 0;
     virtual void thread_loop() = 0;
@@ -0,0 +1,169 @@
+/*
+ * ThreadConfig: 스레드 시작 시 적용하는 실행 환경 설정 (CPU affinity / 스케줄링 / 스택 / 이름 / mlock / NUMA)
+ *
+ * 특징:
+ *  - ThreadConfig 기본값은 기존과 동일하게 아무 설정도 하지 않음 (pthread 기본 속성)
+ *  - Thread::set_thread_config() 또는 ThreadPool::set_thread_config()로 start 전에 지정
+ *  - PThread: cpus_ / sched_* / stack_size_ 를 pthread_attr_t에 담아 pthread_create 시점에 적용
+ *      * pthread_attr_setaffinity_np / pthread_attr_setschedpolicy + setschedparam (PTHREAD_EXPLICIT_SCHED) / pthread_attr_setstacksize
+ *      → 스레드가 처음 실행되는 순간부터 지정 코어 / 우선순위로 동작
+ *  - STDThread: std::thread는 속성을 받을 수 없으므로 새 스레드 안에서 thread_loop 전에
+ *    pthread_setaffinity_np / pthread_setschedparam 으로 적용 (stack_size_ 는 지원하지 않음, [WARN] 후 무시)
+ *  - 공통: 새 스레드 안에서 thread_loop 전에 pthread_setname_np(name_), set_mempolicy(MPOL_BIND, numa_node_)
+ *  - mlock_: start_thread 시 mlockall(MCL_CURRENT | MCL_FUTURE) → 캡처/워커 스레드의 page fault 지연 제거
+ *
+ * 주의:
+ *  - SCHED_FIFO / SCHED_RR, mlockall은 CAP_SYS_NICE / CAP_IPC_LOCK (또는 rlimit) 권한이 필요하다.
+ *    권한이 없으면 [ERROR] 출력 후 start_thread()가 false를 반환한다.
+ *  - 스레드 안에서 적용하는 설정(STDThread의 affinity / 스케줄링)이 실패하면 [ERROR] 출력 후
+ *    thread_loop를 실행하지 않고 종료한다. (get_thread_term() == true)
+ *  - name_ 은 커널 제한으로 15자까지만 적용된다.
+ *  - mlockall은 프로세스 전체에 적용된다.
+ *  - set_mempolicy는 libnuma 없이 syscall로 직접 호출 (커널이 NUMA를 지원하지 않으면 [WARN] 후 무시)
+ *
+ * 사용 예시:
+ *  ThreadConfig cfg;
+ *  cfg.cpus_ = {3};                  // isolcpus로 격리한 코어
+ *  cfg.sched_policy_ = SCHED_FIFO;
+ *  cfg.sched_priority_ = 80;
+ *  cfg.name_ = "capture0";
+ *  cfg.numa_node_ = 0;
+ *  worker.set_thread_config(cfg);
+ *  worker.start_thread();
+ */
+
+#pragma once
+#include <pthread.h>
+#include <sched.h>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+
+#define THREAD_NAME_MAX 15 // pthread_setname_np 최대 길이 (NUL 제외)
+
+struct ThreadConfig {
+    std::vector<int> cpus_;          // 비어 있으면 affinity 지정 없음
+    int sched_policy_ = SCHED_OTHER; // SCHED_OTHER / SCHED_FIFO / SCHED_RR
+    int sched_priority_ = 0;         // SCHED_FIFO / SCHED_RR 우선순위
+    size_t stack_size_ = 0;          // 0 이면 기본 스택 크기
+    std::string name_;               // 비어 있으면 이름 지정 없음
+    bool mlock_ = false;             // mlockall(MCL_CURRENT | MCL_FUTURE)
+    int numa_node_ = -1;             // -1 이면 NUMA 바인딩 없음
+};
+
+namespace ThreadSetup {
+    inline bool has_sched(const ThreadConfig& cfg) {
+        return cfg.sched_policy_ != SCHED_OTHER || cfg.sched_priority_ != 0;
+    }
+
+    inline void fill_cpuset(const ThreadConfig& cfg, cpu_set_t& set) {
+        CPU_ZERO(&set);
+        for (int cpu : cfg.cpus_) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+        }
+    }
+
+    // 프로세스 단위 설정 (start_thread 호출 스레드에서)
+    inline bool apply_process(const ThreadConfig& cfg) {
+        if (cfg.mlock_ && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            std::cerr << "[ERROR] mlockall : " << strerror(errno) << " "
+            << "(ThreadSetup::apply_process) " << '\n';
+            return false;
+        }
+        return true;
+    }
+
+    // pthread_create 속성 구성 (실패 시 attr 해제 후 false)
+    inline bool init_attr(pthread_attr_t* attr, const ThreadConfig& cfg) {
+        int ret = pthread_attr_init(attr);
+        if (ret != 0) {
+            std::cerr << "[ERROR] pthread_attr_init : " << strerror(ret) << " "
+            << "(ThreadSetup::init_attr) " << '\n';
+            return false;
+        }
+        if (cfg.stack_size_ != 0 && (ret = pthread_attr_setstacksize(attr, cfg.stack_size_)) != 0) {
+            std::cerr << "[ERROR] pthread_attr_setstacksize(" << cfg.stack_size_ << ") : " << strerror(ret) << " "
+            << "(ThreadSetup::init_attr) " << '\n';
+            pthread_attr_destroy(attr);
+            return false;
+        }
+        if (!cfg.cpus_.empty()) {
+            cpu_set_t set;
+            fill_cpuset(cfg, set);
+            if ((ret = pthread_attr_setaffinity_np(attr, sizeof(set), &set)) != 0) {
+                std::cerr << "[ERROR] pthread_attr_setaffinity_np : " << strerror(ret) << " "
+                << "(ThreadSetup::init_attr) " << '\n';
+                pthread_attr_destroy(attr);
+                return false;
+            }
+        }
+        if (has_sched(cfg)) {
+            struct sched_param param;
+            std::memset(&param, 0, sizeof(param));
+            param.sched_priority = cfg.sched_priority_;
+            if ((ret = pthread_attr_setinheritsched(attr, PTHREAD_EXPLICIT_SCHED)) != 0
+                || (ret = pthread_attr_setschedpolicy(attr, cfg.sched_policy_)) != 0
+                || (ret = pthread_attr_setschedparam(attr, &param)) != 0) {
+                std::cerr << "[ERROR] pthread_attr_setschedpolicy(" << cfg.sched_policy_ << ", " << cfg.sched_priority_ << ") : "
+                << strerror(ret) << " "
+                << "(ThreadSetup::init_attr) " << '\n';
+                pthread_attr_destroy(attr);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 새 스레드 안에서 thread_loop 전에 적용, with_attr: pthread_attr로 적용하지 못한 affinity / 스케줄링도 적용
+    inline bool apply_self(const ThreadConfig& cfg, bool with_attr) {
+        int ret;
+        if (with_attr && !cfg.cpus_.empty()) {
+            cpu_set_t set;
+            fill_cpuset(cfg, set);
+            if ((ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set)) != 0) {
+                std::cerr << "[ERROR] pthread_setaffinity_np : " << strerror(ret) << " "
+                << "(ThreadSetup::apply_self) " << '\n';
+                return false;
+            }
+        }
+        if (with_attr && has_sched(cfg)) {
+            struct sched_param param;
+            std::memset(&param, 0, sizeof(param));
+            param.sched_priority = cfg.sched_priority_;
+            if ((ret = pthread_setschedparam(pthread_self(), cfg.sched_policy_, &param)) != 0) {
+                std::cerr << "[ERROR] pthread_setschedparam(" << cfg.sched_policy_ << ", " << cfg.sched_priority_ << ") : "
+                << strerror(ret) << " "
+                << "(ThreadSetup::apply_self) " << '\n';
+                return false;
+            }
+        }
+        if (!cfg.name_.empty()) {
+            std::string name = cfg.name_.substr(0, THREAD_NAME_MAX);
+            if ((ret = pthread_setname_np(pthread_self(), name.c_str())) != 0) {
+                std::cerr << "[WARN] pthread_setname_np(" << name << ") : " << strerror(ret) << " "
+                << "(ThreadSetup::apply_self) " << '\n';
+            }
+        }
+        if (cfg.numa_node_ >= 0) {
+            const size_t bits = sizeof(unsigned long) * 8;
+            unsigned long mask[16] = {0};
+            if (static_cast<size_t>(cfg.numa_node_) >= bits * 16) {
+                std::cerr << "[WARN] invalid numa node(" << cfg.numa_node_ << ") "
+                << "(ThreadSetup::apply_self) " << '\n';
+            } else {
+                mask[cfg.numa_node_ / bits] = 1UL << (cfg.numa_node_ % bits);
+                if (syscall(SYS_set_mempolicy, MPOL_BIND, mask, bits * 16) != 0) {
+                    std::cerr << "[WARN] set_mempolicy node(" << cfg.numa_node_ << ") : " << strerror(errno) << " "
+                    << "(ThreadSetup::apply_self) " << '\n';
+                }
+            }
+        }
+        return true;
+    }
+}
@@ -36,6 +36,22 @@ public:
             start_flag_=false;
         }
     }
+    // start_pool() 전에 호출, 모든 스레드를 같은 reclamation 도메인에 연결
+    void set_qsbr_domain(QSBRDomain* qsbr){
+        for(size_t i=0; i < threads_.size();++i){
+            threads_[i]->set_qsbr_domain(qsbr);
+        }
+    }
+    // start_pool() 전에 호출, idx번째 스레드의 실행 환경 지정
+    bool set_thread_config(size_t idx, const ThreadConfig& cfg){
+        if(idx >= threads_.size()){
+            std::cerr << "[ERROR] invalid thread index(" << idx << ") "
+            << "(ThreadPool::set_thread_config) " << '\n';
+            return false;
+        }
+        threads_[idx]->set_thread_config(cfg);
+        return true;
+    }
     virtual bool monitor_pool() = 0;
     virtual ~ThreadPool(){}
 };
\ No newline at end of file